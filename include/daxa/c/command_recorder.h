@@ -24,10 +24,25 @@ typedef struct
 {
     daxa_QueueFamily queue_family;
     daxa_SmallString name;
+    // Executable command lists of the recorder can be submitted any number of times, also while previous submits are in flight.
+    // Deferred destructions of such lists run once the list is destroyed, instead of on submit.
+    daxa_Bool8 reusable_command_lists;
+    // Pipeline binds, index buffer binds and dynamic state that do not change the current state are dropped.
+    daxa_Bool8 filter_redundant_state;
 } daxa_CommandRecorderInfo;
 
 static daxa_CommandRecorderInfo const DAXA_DEFAULT_COMMAND_RECORDER_INFO = DAXA_ZERO_INIT;
 
+// Counts of the calls dropped by redundant state filtering, over the lifetime of the recorder.
+typedef struct
+{
+    daxa_u64 elided_pipeline_binds;
+    daxa_u64 elided_index_buffer_binds;
+    daxa_u64 elided_viewports;
+    daxa_u64 elided_scissors;
+    daxa_u64 elided_depth_biases;
+} daxa_CommandRecorderStats;
+
 typedef struct
 {
     daxa_ImageId src_image;
@@ -195,10 +210,35 @@ typedef struct
     daxa_Optional(daxa_RenderAttachmentInfo) depth_attachment;
     daxa_Optional(daxa_RenderAttachmentInfo) stencil_attachment;
     VkRect2D render_area;
+    // The renderpass contents are recorded by secondary command recorders and executed with daxa_cmd_execute_commands.
+    // No other commands may be recorded into the renderpass then.
+    daxa_Bool8 secondary_command_lists;
 } daxa_RenderPassBeginInfo;
 
 static daxa_RenderPassBeginInfo const DAXA_DEFAULT_RENDERPASS_BEGIN_INFO = DAXA_ZERO_INIT;
 
+// Describes the renderpass, secondary command lists are executed in.
+// Must match the daxa_RenderPassBeginInfo of the renderpass.
+typedef struct
+{
+    daxa_FixedList(VkFormat, 8) color_attachment_formats;
+    VkFormat depth_attachment_format;
+    VkFormat stencil_attachment_format;
+    VkSampleCountFlagBits rasterization_samples;
+    // Used to set the initial viewport and scissor, like daxa_cmd_begin_renderpass does.
+    VkRect2D render_area;
+    daxa_SmallString name;
+} daxa_RenderPassInheritInfo;
+
+static daxa_RenderPassInheritInfo const DAXA_DEFAULT_RENDER_PASS_INHERIT_INFO = {
+    .color_attachment_formats = DAXA_ZERO_INIT,
+    .depth_attachment_format = VK_FORMAT_UNDEFINED,
+    .stencil_attachment_format = VK_FORMAT_UNDEFINED,
+    .rasterization_samples = VK_SAMPLE_COUNT_1_BIT,
+    .render_area = DAXA_ZERO_INIT,
+    .name = DAXA_ZERO_INIT,
+};
+
 typedef struct
 {
     uint32_t width;
@@ -446,6 +486,11 @@ daxa_cmd_pipeline_barrier(daxa_CommandRecorder cmd_enc, daxa_MemoryBarrierInfo c
 /// @param info parameters.
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_pipeline_barrier_image_transition(daxa_CommandRecorder cmd_enc, daxa_ImageMemoryBarrierInfo const * info);
+/// @brief  Successive pipeline barrier calls are combined.
+///         As soon as a non-pipeline barrier command is recorded, the currently recorded barriers are flushed with a vkCmdPipelineBarrier2 call.
+/// @param info parameters.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_cmd_pipeline_barrier_buffer(daxa_CommandRecorder cmd_enc, daxa_BufferMemoryBarrierInfo const * info);
 DAXA_EXPORT void
 daxa_cmd_signal_event(daxa_CommandRecorder cmd_enc, daxa_EventSignalInfo const * info);
 DAXA_EXPORT void
@@ -468,6 +513,9 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_dispatch(daxa_CommandRecorder cmd_enc, daxa_DispatchInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_dispatch_indirect(daxa_CommandRecorder cmd_enc, daxa_DispatchIndirectInfo const * info);
+/// @brief  Records count dispatches with the bound compute pipeline, validating and flushing barriers only once.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_cmd_dispatch_multi(daxa_CommandRecorder cmd_enc, daxa_DispatchInfo const * infos, uint32_t count);
 
 /// @brief  Destroys the buffer AFTER the gpu is finished executing the command list.
 ///         Useful for large uploads exceeding staging memory pools.
@@ -503,8 +551,22 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_begin_renderpass(daxa_CommandRecorder cmd_enc, daxa_RenderPassBeginInfo const * info);
 /// @brief  Ends a renderpass scope akin to the dynamic rendering feature in vulkan.
 ///         Between the begin and end renderpass commands, the renderpass persists and draw-calls can be recorded.
+///         Secondary recorders can not end the renderpass they record into, that is done by their primary.
 DAXA_EXPORT void
 daxa_cmd_end_renderpass(daxa_CommandRecorder cmd_enc);
+/// @brief  Creates a secondary command recorder, recording commands into a renderpass of this recorder.
+///         Secondary recorders start inside the renderpass and can be used on other threads than the primary recorder.
+///         Their completed command lists can not be submitted, they are executed with daxa_cmd_execute_commands instead.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_cmd_create_secondary(daxa_CommandRecorder cmd_enc, daxa_RenderPassInheritInfo const * info, daxa_CommandRecorder * out_secondary);
+/// @brief  Executes completed secondary command lists inside the current renderpass.
+///         The used ids and deferred destructions of the secondary lists are merged into this recorder.
+///         The secondary lists are kept alive until the command list of this recorder is destroyed.
+///         Pipelines and other state have to be set again after this command.
+///         Between beginning such a renderpass and ending it, the primary can not record draws or set state.
+///         Validation builds reject setting a raster pipeline there.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_cmd_execute_commands(daxa_CommandRecorder cmd_enc, daxa_ExecutableCommandList const * secondary_cmd_lists, uint32_t count);
 DAXA_EXPORT void
 daxa_cmd_set_viewport(daxa_CommandRecorder cmd_enc, VkViewport const * info);
 DAXA_EXPORT void
@@ -518,6 +580,11 @@ DAXA_EXPORT void
 daxa_cmd_draw(daxa_CommandRecorder cmd_enc, daxa_DrawInfo const * info);
 DAXA_EXPORT void
 daxa_cmd_draw_indexed(daxa_CommandRecorder cmd_enc, daxa_DrawIndexedInfo const * info);
+/// @brief  Records count indexed draws.
+///         Uses vkCmdDrawMultiIndexedEXT when DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW is available,
+///         where consecutive draws with equal instance_count and first_instance are combined into one call.
+DAXA_EXPORT void
+daxa_cmd_draw_indexed_multi(daxa_CommandRecorder cmd_enc, daxa_DrawIndexedInfo const * infos, uint32_t count);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_draw_indirect(daxa_CommandRecorder cmd_enc, daxa_DrawIndirectInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
@@ -549,6 +616,8 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_complete_current_commands(daxa_CommandRecorder cmd_enc, daxa_ExecutableCommandList * out_executable_cmds);
 DAXA_EXPORT daxa_CommandRecorderInfo const *
 daxa_cmd_info(daxa_CommandRecorder cmd_enc);
+DAXA_EXPORT void
+daxa_cmd_stats(daxa_CommandRecorder cmd_enc, daxa_CommandRecorderStats * out_stats);
 DAXA_EXPORT VkCommandBuffer
 daxa_cmd_get_vk_command_buffer(daxa_CommandRecorder cmd_enc);
 DAXA_EXPORT VkCommandPool
@@ -238,6 +238,7 @@ typedef enum
     DAXA_MISSING_REQUIRED_VK_FEATURE_VULKAN_MEMORY_MODEL,
     DAXA_MISSING_REQUIRED_VK_FEATURE_ROBUST_BUFFER_ACCESS2,
     DAXA_MISSING_REQUIRED_VK_FEATURE_ROBUST_IMAGE_ACCESS2,
+    DAXA_MISSING_REQUIRED_VK_FEATURE_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT,
     DAXA_MISSING_REQUIRED_VK_FEATURE_MAX_ENUM
 } daxa_MissingRequiredVkFeature;
 
@@ -272,6 +273,8 @@ typedef enum
     DAXA_IMPLICIT_FEATURE_FLAG_SHADER_INT16 = 0x1 << 13,
     DAXA_IMPLICIT_FEATURE_FLAG_SHADER_CLOCK = 0x1 << 14,
     DAXA_IMPLICIT_FEATURE_FLAG_LINE_RASTERIZATION = 0x1 << 15,
+    DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER = 0x1 << 16,
+    DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW = 0x1 << 17,
 } daxa_DeviceImplicitFeatureFlagBits;
 
 typedef daxa_DeviceImplicitFeatureFlagBits daxa_ImplicitFeatureFlags;
@@ -354,6 +357,20 @@ typedef struct
     uint32_t max_allowed_buffers;
     uint32_t max_allowed_samplers;
     uint32_t max_allowed_acceleration_structures;
+    // The resource table grows towards these limits at runtime, once the max_allowed_* limits are exhausted.
+    // Values below the matching max_allowed_* limit disable growth.
+    // Buffer descriptors are reallocated on growth. Vulkan allows only one variable sized binding,
+    // so image and sampler descriptors are reserved for the growth limit up front.
+    // Command recorders pick up grown buffer descriptors the next time they set a pipeline.
+    uint32_t max_growable_images;
+    uint32_t max_growable_buffers;
+    uint32_t max_growable_samplers;
+    // Starts a device owned thread, that destroys zombies as soon as the gpu is done with them.
+    // The thread stops on fatal errors like a lost device, following submits, presents, garbage collections and idle waits return that error.
+    daxa_Bool8 enable_background_garbage_collection;
+    // Command recorders skip remembering used ids and submits skip validating them.
+    // Has no effect when built with DAXA_TRACK_IDS 0, tracking is always off then.
+    daxa_Bool8 disable_id_tracking;
     daxa_SmallString name;
 } daxa_DeviceInfo2;
 
@@ -364,9 +381,26 @@ static daxa_DeviceInfo2 const DAXA_DEFAULT_DEVICE_INFO_2 = {
     .max_allowed_buffers = 10000,
     .max_allowed_samplers = 400,
     .max_allowed_acceleration_structures = 10000,
+    .max_growable_images = 0,
+    .max_growable_buffers = 0,
+    .max_growable_samplers = 0,
+    .enable_background_garbage_collection = 0,
+    .disable_id_tracking = 0,
     .name = DAXA_ZERO_INIT,
 };
 
+// Limits the work of a single daxa_dvc_collect_garbage_budgeted call. A limit of 0 is unlimited.
+typedef struct
+{
+    uint32_t max_destroyed_objects;
+    uint64_t max_microseconds;
+} daxa_GarbageCollectBudget;
+
+static daxa_GarbageCollectBudget const DAXA_DEFAULT_GARBAGE_COLLECT_BUDGET = {
+    .max_destroyed_objects = 0,
+    .max_microseconds = 0,
+};
+
 typedef struct
 {
     daxa_QueueFamily family;
@@ -388,15 +422,24 @@ static daxa_Queue const DAXA_QUEUE_TRANSFER_1 = {DAXA_QUEUE_FAMILY_TRANSFER, 1};
 typedef struct
 {
     daxa_Queue queue;
-    VkPipelineStageFlags wait_stages;
+    // Stages that wait on the wait semaphores. Zero waits with all commands.
+    // Applies to every wait that has no own stage mask in wait_*_semaphore_stages.
+    // Holds synchronization2 stages, the field is 64 bit wide since vkQueueSubmit2 is used.
+    VkPipelineStageFlags2 wait_stages;
     daxa_ExecutableCommandList const * command_lists;
     uint64_t command_list_count;
     daxa_BinarySemaphore const * wait_binary_semaphores;
     uint64_t wait_binary_semaphore_count;
+    // Optional stage masks, one per wait binary semaphore. The count is either zero or wait_binary_semaphore_count.
+    VkPipelineStageFlags2 const * wait_binary_semaphore_stages;
+    uint64_t wait_binary_semaphore_stage_count;
     daxa_BinarySemaphore const * signal_binary_semaphores;
     uint64_t signal_binary_semaphore_count;
     daxa_TimelinePair const * wait_timeline_semaphores;
     uint64_t wait_timeline_semaphore_count;
+    // Optional stage masks, one per wait timeline semaphore. The count is either zero or wait_timeline_semaphore_count.
+    VkPipelineStageFlags2 const * wait_timeline_semaphore_stages;
+    uint64_t wait_timeline_semaphore_stage_count;
     daxa_TimelinePair const * signal_timeline_semaphores;
     uint64_t signal_timeline_semaphore_count;
 } daxa_CommandSubmitInfo;
@@ -512,8 +555,48 @@ typedef struct
 
 static daxa_DeviceMemoryReport const DAXA_DEFAULT_DEVICE_MEMORY_REPORT_INFO = DAXA_ZERO_INIT;
 
+// Always on counters of a resource pool.
+// The counters are read without synchronization, so they can be slightly inconsistent with each other.
+typedef struct
+{
+    // Number of slots that can be used right now, grows up to the growable limit.
+    daxa_u32 capacity;
+    // Slots holding a resource, including destroyed resources waiting for garbage collection.
+    daxa_u32 live_slots;
+    // Slots ready to be recycled.
+    daxa_u32 free_slots;
+    // Slots that reached the maximum id version, they are never recycled.
+    daxa_u32 retired_slots;
+    // Totals over the lifetime of the device.
+    daxa_u64 created;
+    daxa_u64 destroyed;
+    // Destroyed resources waiting for garbage collection.
+    daxa_u64 zombies;
+} daxa_ResourcePoolStats;
+
+typedef struct
+{
+    daxa_ResourcePoolStats buffers;
+    // Image views share the image pool.
+    daxa_ResourcePoolStats images;
+    daxa_ResourcePoolStats samplers;
+    daxa_ResourcePoolStats tlas;
+    daxa_ResourcePoolStats blas;
+    // Zombies of all kinds, including command lists, pipelines and semaphores.
+    daxa_u64 total_zombies;
+    // Descriptor writes queued into the resource table.
+    daxa_u64 descriptor_writes;
+    // Coalesced resource table updates the queued writes were flushed in.
+    daxa_u64 descriptor_write_flushes;
+    // Indexed by main queue, then compute queues, then transfer queues.
+    daxa_u64 queue_submits[1 + DAXA_MAX_COMPUTE_QUEUE_COUNT + DAXA_MAX_TRANSFER_QUEUE_COUNT];
+} daxa_DeviceStats;
+
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_device_memory_report(daxa_Device device, daxa_DeviceMemoryReport * report);
+// Cheap enough to be called every frame. Totals are monotonic, per frame values can be derived by diffing two calls.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_stats(daxa_Device device, daxa_DeviceStats * out_stats);
 DAXA_EXPORT DAXA_NO_DISCARD VkMemoryRequirements
 daxa_dvc_buffer_memory_requirements(daxa_Device device, daxa_BufferInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD VkMemoryRequirements
@@ -537,6 +620,16 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_image_view(daxa_Device device, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_sampler(daxa_Device device, daxa_SamplerInfo const * info, daxa_SamplerId * out_id);
+
+/// @brief  Batched versions of the create functions above.
+///         Writes the descriptors of all created resources with a single descriptor set update.
+///         Either all resources are created or none. On failure, all out ids are left empty.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_buffers(daxa_Device device, daxa_BufferInfo const * infos, daxa_BufferId * out_ids, daxa_u32 count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_images(daxa_Device device, daxa_ImageInfo const * infos, daxa_ImageId * out_ids, daxa_u32 count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_image_views(daxa_Device device, daxa_ImageViewInfo const * infos, daxa_ImageViewId * out_ids, daxa_u32 count);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_tlas(daxa_Device device, daxa_TlasInfo const * info, daxa_TlasId * out_id);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
@@ -644,10 +737,19 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_wait_idle(daxa_Device device);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_submit(daxa_Device device, daxa_CommandSubmitInfo const * info);
+// Submits all infos in the given order. Each run of consecutive infos to the same queue is issued with one vkQueueSubmit2.
+// Order the infos so that submits to the same queue follow each other, to get the fewest vkQueueSubmit2 calls.
+// Binary semaphores must be signaled by an earlier info than the one waiting on them, just like with single submits.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_submit_batch(daxa_Device device, daxa_CommandSubmitInfo const * infos, uint64_t info_count);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_present(daxa_Device device, daxa_PresentInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_collect_garbage(daxa_Device device);
+// Same as daxa_dvc_collect_garbage, but stops once the budget is used up. Later calls resume with the remaining zombies.
+// Optionally writes the number of zombies left after the call (ready or still in use by the gpu) into out_remaining_zombies.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_collect_garbage_budgeted(daxa_Device device, daxa_GarbageCollectBudget const * budget, uint64_t * out_remaining_zombies);
 
 DAXA_EXPORT daxa_DeviceInfo2 const *
 daxa_dvc_info(daxa_Device device);
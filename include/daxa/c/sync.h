@@ -108,6 +108,16 @@ typedef struct
     daxa_ImageId image_id;
 } daxa_ImageMemoryBarrierInfo;
 
+typedef struct
+{
+    daxa_Access src_access;
+    daxa_Access dst_access;
+    daxa_BufferId buffer_id;
+    uint64_t offset;
+    // VK_WHOLE_SIZE covers the rest of the buffer after offset.
+    uint64_t size;
+} daxa_BufferMemoryBarrierInfo;
+
 typedef struct
 {
     daxa_SmallString name;
@@ -126,6 +126,15 @@ typedef enum
     DAXA_RESULT_ERROR_COMPUTE_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER = (1 << 30) + 72,
     DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER = (1 << 30) + 73,
     DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_COMPUTE_QUEUE_RECORDER = (1 << 30) + 74,
+    DAXA_RESULT_ERROR_SECONDARY_CMD_LIST_SUBMITTED = (1 << 30) + 75,
+    DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_SECONDARY = (1 << 30) + 76,
+    DAXA_RESULT_ERROR_NOT_IN_SECONDARY_RENDERPASS = (1 << 30) + 77,
+    DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_REUSABLE = (1 << 30) + 78,
+    DAXA_RESULT_ERROR_CMD_LIST_ALREADY_SUBMITTED = (1 << 30) + 79,
+    DAXA_RESULT_ERROR_CMD_IN_SECONDARY_RENDERPASS = (1 << 30) + 80,
+    DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_DEVICE_MISMATCH = (1 << 30) + 81,
+    DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_QUEUE_FAMILY_MISMATCH = (1 << 30) + 82,
+    DAXA_RESULT_ERROR_WAIT_STAGE_COUNT_MISMATCH = (1 << 30) + 83,
     DAXA_RESULT_MAX_ENUM = 0x7FFFFFFF,
 } daxa_Result;
 
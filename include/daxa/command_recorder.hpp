@@ -21,6 +21,23 @@ namespace daxa
     {
         QueueFamily queue_family = {};
         SmallString name = {};
+        /// @brief  Executable command lists of the recorder can be submitted any number of times, also while previous submits are in flight.
+        ///         They stay valid until they are destroyed, deferred destructions run then instead of on submit.
+        ///         Secondary recorders inherit this from their primary.
+        bool reusable_command_lists = {};
+        /// @brief  Pipeline binds, index buffer binds and dynamic state that do not change the current state are dropped.
+        ///         Secondary recorders inherit this from their primary.
+        bool filter_redundant_state = {};
+    };
+
+    /// @brief  Counts of the calls dropped by redundant state filtering, over the lifetime of the recorder.
+    struct CommandRecorderStats
+    {
+        u64 elided_pipeline_binds = {};
+        u64 elided_index_buffer_binds = {};
+        u64 elided_viewports = {};
+        u64 elided_scissors = {};
+        u64 elided_depth_biases = {};
     };
 
     struct ImageBlitInfo
@@ -128,6 +145,22 @@ namespace daxa
         Optional<RenderAttachmentInfo> depth_attachment = {};
         Optional<RenderAttachmentInfo> stencil_attachment = {};
         Rect2D render_area = {};
+        /// @brief  The renderpass contents are recorded by secondary command recorders and executed with execute_commands.
+        ///         No other commands may be recorded into the renderpass then.
+        bool secondary_command_lists = {};
+    };
+
+    /// @brief  Describes the renderpass, secondary command lists are executed in.
+    ///         Must match the RenderPassBeginInfo of the renderpass.
+    struct RenderPassInheritInfo
+    {
+        FixedList<Format, 8> color_attachment_formats = {};
+        Format depth_attachment_format = Format::UNDEFINED;
+        Format stencil_attachment_format = Format::UNDEFINED;
+        RasterizationSamples rasterization_samples = RasterizationSamples::E1;
+        /// @brief  Used to set the initial viewport and scissor, like begin_renderpass does.
+        Rect2D render_area = {};
+        SmallString name = {};
     };
 
     struct TraceRaysInfo
@@ -309,10 +342,14 @@ namespace daxa
         ///         Between the begin and end renderpass commands, the renderpass persists and drawcalls can be recorded.
         [[nodiscard]] auto end_renderpass() && -> CommandRecorder;
 
+        /// @brief  In release builds, exactly info.size bytes are pushed when the size is a multiple of 4.
+        ///         Otherwise the rest of the pipelines push constant range is filled with 0xFF.
         void push_constant_vptr(PushConstantInfo const & info);
+        /// @brief  Pushes the constant directly from its memory, the size is checked at compile time.
         template <typename T>
         void push_constant(T const & constant, [[maybe_unused]] [[deprecated("parameter ignored. API: 3.1")]] u32 offset = 0)
         {
+            static_assert(sizeof(T) <= DAXA_MAX_PUSH_CONSTANT_BYTE_SIZE, "push constant exceeds the maximum push constant size");
             push_constant_vptr({
                 .data = static_cast<void const *>(&constant),
                 .size = static_cast<u32>(sizeof(T)),
@@ -327,11 +364,25 @@ namespace daxa
 
         void draw(DrawInfo const & info);
         void draw_indexed(DrawIndexedInfo const & info);
+        /// @brief  Records all draws in one call.
+        ///         Uses VK_EXT_multi_draw when ImplicitFeatureFlagBits::MULTI_DRAW is available,
+        ///         where consecutive draws with equal instance_count and first_instance are combined into one vulkan call.
+        void draw_indexed_multi(daxa::Span<DrawIndexedInfo const> const & infos);
         void draw_indirect(DrawIndirectInfo const & info);
         void draw_indirect_count(DrawIndirectCountInfo const & info);
         void draw_mesh_tasks(u32 x, u32 y, u32 z);
         void draw_mesh_tasks_indirect(DrawMeshTasksIndirectInfo const & info);
         void draw_mesh_tasks_indirect_count(DrawMeshTasksIndirectCountInfo const & info);
+
+        /// @brief  Creates a secondary recorder, recording into this renderpass. See CommandRecorder::create_secondary.
+        [[nodiscard]] auto create_secondary(RenderPassInheritInfo const & info) -> RenderCommandRecorder;
+        /// @brief  Executes completed secondary command lists.
+        ///         The renderpass must have been begun with RenderPassBeginInfo::secondary_command_lists.
+        ///         Pipelines and other state have to be set again afterwards.
+        void execute_commands(daxa::Span<ExecutableCommandList const> const & secondary_command_lists);
+        /// @brief  Only valid for secondary recorders, completes the commands recorded so far.
+        ///         The secondary recorder stays inside the renderpass, so it can record further command lists.
+        [[nodiscard]] auto complete_current_commands() -> ExecutableCommandList;
     };
 
     /**
@@ -349,9 +400,8 @@ namespace daxa
      * * can be passed between different threads
      * * may only be accessed by one thread at a time
      * WARNING:
-     * * creating a command list, it will LOCK resource lifetimes
-     * * calling collect_garbage will BLOCK until all resource lifetime locks have been unlocked
-     * * completing a command list will remove its lock on the resource lifetimes
+     * * resources destroyed while a command recorder is alive are kept alive until the recorder is destroyed
+     * * collect_garbage never waits for command recorders, it leaves those resources for later calls
      * * most record commands can throw exceptions on invalid inputs such as invalid ids
      * * using deferred destructions will make the completed command list not reusable,
      *   as resources can only be destroyed once
@@ -390,6 +440,10 @@ namespace daxa
         ///         As soon as a non-pipeline barrier command is recorded, the currently recorded barriers are flushed with a vkCmdPipelineBarrier2 call.
         /// @param info parameters.
         void pipeline_barrier_image_transition(ImageMemoryBarrierInfo const & info);
+        /// @brief  Successive pipeline barrier calls are combined.
+        ///         As soon as a non-pipeline barrier command is recorded, the currently recorded barriers are flushed with a vkCmdPipelineBarrier2 call.
+        /// @param info parameters.
+        void pipeline_barrier_buffer(BufferMemoryBarrierInfo const & info);
         void signal_event(EventSignalInfo const & info);
         void wait_events(daxa::Span<EventWaitInfo const> const & infos);
         void wait_event(EventWaitInfo const & info);
@@ -428,16 +482,21 @@ namespace daxa
         /// * reference MUST NOT be read after the device is destroyed.
         /// @return reference to info of object.
         [[nodiscard]] auto info() const -> CommandRecorderInfo const &;
+        [[nodiscard]] auto stats() const -> CommandRecorderStats;
 
 
         /// ============= Compute Queue Legal Commands ============= ///
 
 
+        /// @brief  In release builds, exactly info.size bytes are pushed when the size is a multiple of 4.
+        ///         Otherwise the rest of the pipelines push constant range is filled with 0xFF.
         void push_constant_vptr(PushConstantInfo const & info);
 
+        /// @brief  Pushes the constant directly from its memory, the size is checked at compile time.
         template <typename T>
         void push_constant(T const & constant)
         {
+            static_assert(sizeof(T) <= DAXA_MAX_PUSH_CONSTANT_BYTE_SIZE, "push constant exceeds the maximum push constant size");
             push_constant_vptr({
                 .data = &constant,
                 .size = static_cast<u32>(sizeof(T))
@@ -449,6 +508,8 @@ namespace daxa
         void set_pipeline(ComputePipeline const & pipeline);
 
         void dispatch(DispatchInfo const & info);
+        /// @brief  Records all dispatches in one call, validating and flushing barriers only once.
+        void dispatch_multi(daxa::Span<DispatchInfo const> const & infos);
 
         void dispatch_indirect(DispatchIndirectInfo const & info);
 
@@ -466,5 +527,12 @@ namespace daxa
         ///         Between the begin and end renderpass commands, the renderpass persists and drawcalls can be recorded.
         /// @param info parameters.
         [[nodiscard]] auto begin_renderpass(RenderPassBeginInfo const & info) && -> RenderCommandRecorder;
+
+        /// @brief  Creates a secondary recorder, that records commands into a renderpass of this recorder.
+        ///         Secondary recorders can be passed to worker threads, to record a renderpass in parallel.
+        ///         Their completed command lists are executed with RenderCommandRecorder::execute_commands.
+        ///         Used ids and deferred destructions of secondary command lists are merged into this recorder on execution.
+        /// @param info describes the renderpass the secondary commands are executed in.
+        [[nodiscard]] auto create_secondary(RenderPassInheritInfo const & info) -> RenderCommandRecorder;
     };
 } // namespace daxa
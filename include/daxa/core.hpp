@@ -51,6 +51,13 @@
 #define DAXA_GPU_ID_VALIDATION 0
 #endif
 
+// Command recorders remember the ids used by each command list, so that submits can validate them.
+// Shipping builds can define this to 0, which strips id tracking and submit validation entirely.
+// Deferred destructions are not affected.
+#if !defined(DAXA_TRACK_IDS)
+#define DAXA_TRACK_IDS 1
+#endif
+
 #if !defined(DAXA_REMOVE_DEPRECATED)
 #define DAXA_REMOVE_DEPRECATED 1
 #endif
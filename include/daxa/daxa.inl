@@ -2,12 +2,13 @@
 #define DAXA_DAXA_INL
 
 #define DAXA_GPU_TABLE_SET_BINDING 0
-#define DAXA_STORAGE_BUFFER_BINDING 0
 #define DAXA_STORAGE_IMAGE_BINDING 1
 #define DAXA_SAMPLED_IMAGE_BINDING 2
 #define DAXA_SAMPLER_BINDING 3
 #define DAXA_BUFFER_DEVICE_ADDRESS_BUFFER_BINDING 4
 #define DAXA_ACCELERATION_STRUCTURE_BINDING 5
+// Must stay the highest binding, it has a variable descriptor count so that the buffer table can grow.
+#define DAXA_STORAGE_BUFFER_BINDING 6
 
 #define DAXA_LANGUAGE_C 0
 #define DAXA_LANGUAGE_CPP 0
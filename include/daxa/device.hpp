@@ -260,6 +260,7 @@ namespace daxa
         VULKAN_MEMORY_MODEL,
         ROBUST_BUFFER_ACCESS2,
         ROBUST_IMAGE_ACCESS2,
+        DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT,
         MAX_ENUM
     };
 
@@ -302,6 +303,8 @@ namespace daxa
         static inline constexpr ImplicitFeatureFlags SHADER_INT16 = {0x1 << 13};
         static inline constexpr ImplicitFeatureFlags SHADER_CLOCK = {0x1 << 14};
         static inline constexpr ImplicitFeatureFlags LINE_RASTERIZATION = {0x1 << 15};
+        static inline constexpr ImplicitFeatureFlags DESCRIPTOR_BUFFER = {0x1 << 16};
+        static inline constexpr ImplicitFeatureFlags MULTI_DRAW = {0x1 << 17};
     };
 
     struct DeviceProperties
@@ -355,9 +358,32 @@ namespace daxa
         u32 max_allowed_buffers = 10'000;
         u32 max_allowed_samplers = 400;
         u32 max_allowed_acceleration_structures = 10'000;
+        // The resource table grows towards these limits at runtime, once the max_allowed_* limits are exhausted.
+        // Resource ids stay valid across growth. Values below the matching max_allowed_* limit disable growth.
+        // The table layout is sized for these limits, so the device must support them just like the max_allowed_* limits.
+        // Buffer descriptors are reallocated on growth. Vulkan allows only one variable sized binding,
+        // so image and sampler descriptors are reserved for the growth limit up front.
+        // Command recorders pick up grown buffer descriptors the next time they set a pipeline.
+        u32 max_growable_images = 0;
+        u32 max_growable_buffers = 0;
+        u32 max_growable_samplers = 0;
+        // Starts a device owned thread, that destroys zombies as soon as the gpu is done with them.
+        // The thread never waits for command recorders, collect_garbage calls are optional then.
+        // The thread stops on fatal errors like a lost device, following submits, presents, collect_garbage and wait_idle calls return that error.
+        bool enable_background_garbage_collection = {};
+        // Command recorders skip remembering used ids and submits skip validating them.
+        // Has no effect when built with DAXA_TRACK_IDS 0, tracking is always off then.
+        bool disable_id_tracking = {};
         SmallString name = {};
     };
 
+    /// @brief  Limits the work of a single Device::collect_garbage call. A limit of 0 is unlimited.
+    struct GarbageCollectBudget
+    {
+        u32 max_destroyed_objects = {};
+        u64 max_microseconds = {};
+    };
+
     struct Queue
     {
         QueueFamily family = {};
@@ -379,11 +405,17 @@ namespace daxa
     struct CommandSubmitInfo
     {
         Queue queue = daxa::QUEUE_MAIN;
+        // Applies to all wait semaphores without an own stage mask in wait_*_semaphore_stages.
+        // Empty waits with all commands.
         PipelineStageFlags wait_stages = {};
         daxa::Span<ExecutableCommandList const> command_lists = {};
         daxa::Span<BinarySemaphore const> wait_binary_semaphores = {};
+        // Optional, empty or one stage mask per wait binary semaphore.
+        daxa::Span<PipelineStageFlags const> wait_binary_semaphore_stages = {};
         daxa::Span<BinarySemaphore const> signal_binary_semaphores = {};
         daxa::Span<std::pair<TimelineSemaphore, u64> const> wait_timeline_semaphores = {};
+        // Optional, empty or one stage mask per wait timeline semaphore.
+        daxa::Span<PipelineStageFlags const> wait_timeline_semaphore_stages = {};
         daxa::Span<std::pair<TimelineSemaphore, u64> const> signal_timeline_semaphores = {};
     };
 
@@ -483,6 +515,37 @@ namespace daxa
         MemoryBLockDeviceMemorySizePair * memory_block_list = {};
     };
     
+    /// @brief  Always on counters of a resource pool.
+    ///         The counters are read without synchronization, so they can be slightly inconsistent with each other.
+    struct ResourcePoolStats
+    {
+        /// @brief  Number of slots that can be used right now, grows up to the growable limit.
+        u32 capacity = {};
+        /// @brief  Slots holding a resource, including destroyed resources waiting for garbage collection.
+        u32 live_slots = {};
+        u32 free_slots = {};
+        /// @brief  Slots that reached the maximum id version, they are never recycled.
+        u32 retired_slots = {};
+        u64 created = {};
+        u64 destroyed = {};
+        u64 zombies = {};
+    };
+
+    struct DeviceStats
+    {
+        ResourcePoolStats buffers = {};
+        /// @brief  Image views share the image pool.
+        ResourcePoolStats images = {};
+        ResourcePoolStats samplers = {};
+        ResourcePoolStats tlas = {};
+        ResourcePoolStats blas = {};
+        u64 total_zombies = {};
+        u64 descriptor_writes = {};
+        u64 descriptor_write_flushes = {};
+        /// @brief  Indexed by main queue, then compute queues, then transfer queues.
+        std::array<u64, 1 + MAX_COMPUTE_QUEUE_COUNT + MAX_TRANSFER_QUEUE_COUNT> queue_submits = {};
+    };
+
     struct DeviceMemoryReportConvenient
     {
         u64 total_device_memory_use = {};
@@ -521,6 +584,9 @@ namespace daxa
 
         void device_memory_report(DeviceMemoryReport & out_report) const;
         [[nodiscard]] auto device_memory_report_convenient() const -> DeviceMemoryReportConvenient;
+        /// @brief  Cheap enough to be called every frame.
+        ///         Totals are monotonic, per frame values can be derived by diffing two calls.
+        [[nodiscard]] auto stats() const -> DeviceStats;
         [[nodiscard]] auto buffer_memory_requirements(BufferInfo const & info) const -> MemoryRequirements;
         [[nodiscard]] auto image_memory_requirements(ImageInfo const & info) const -> MemoryRequirements;
         [[nodiscard]] auto memory_requirements(BufferInfo const & info) const { return buffer_memory_requirements(info); }
@@ -536,6 +602,13 @@ namespace daxa
         [[nodiscard]] auto create_blas(BlasInfo const & info) -> BlasId;
         [[nodiscard]] auto create_tlas_from_buffer(BufferTlasInfo const & info) -> TlasId;
         [[nodiscard]] auto create_blas_from_buffer(BufferBlasInfo const & info) -> BlasId;
+        /// @brief  Creates many resources at once, writing all their descriptors in one descriptor set update.
+        ///         Either all resources are created or none.
+        /// @param infos create infos of the resources.
+        /// @param out_ids receives the created ids, must be at least as large as infos.
+        void create_buffers(std::span<BufferInfo const> infos, std::span<BufferId> out_ids);
+        void create_images(std::span<ImageInfo const> infos, std::span<ImageId> out_ids);
+        void create_image_views(std::span<ImageViewInfo const> infos, std::span<ImageViewId> out_ids);
         [[nodiscard]] auto create(BufferInfo const & info) { return create_buffer(info); }
         [[nodiscard]] auto create(ImageInfo const & info) { return create_image(info); }
         [[nodiscard]] auto create(MemoryBlockBufferInfo const & info) { return create_buffer_from_memory_block(info); }
@@ -633,18 +706,23 @@ namespace daxa
         auto queue_count(QueueFamily queue_count) -> u32;
 
         void submit_commands(CommandSubmitInfo const & submit_info);
+        /// @brief  Submits many CommandSubmitInfos in the given order.
+        ///         Each run of consecutive submits to the same queue is issued with one vkQueueSubmit2.
+        ///         Binary semaphores must be signaled by an earlier submit than the one waiting on them, just like with single submits.
+        void submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos);
         void present_frame(PresentInfo const & info);
 
         /// @brief  Actually destroys all resources that are ready to be destroyed.
         ///         When calling destroy, or removing all references to an object, it is zombified not really destroyed.
         ///         A zombie lives until the gpu catches up to the point of zombification.
         /// NOTE:
-        /// * this function will block until it gains an exclusive resource lock
-        /// * command lists may hold shared lifetime locks, those must all unlock before an exclusive lock can be made
+        /// * never blocks on command recorders, resources destroyed while a recorder is alive are kept until it is destroyed
         /// * look at CommandRecorder for more info on this
-        /// * SoftwareCommandRecorder is exempt from this limitation,
-        ///   you can freely record those in parallel with collect_garbage
         void collect_garbage();
+        /// @brief  Same as collect_garbage, but stops once the budget is used up.
+        ///         Following calls resume with the remaining zombies, allowing to spread large cleanups over multiple frames.
+        /// @return number of zombies left after the call, ready or still in use by the gpu.
+        auto collect_garbage(GarbageCollectBudget const & budget) -> u64;
 
         /// THREADSAFETY:
         /// * reference MUST NOT be read after the device is destroyed.
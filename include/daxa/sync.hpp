@@ -27,6 +27,18 @@ namespace daxa
 
     [[nodiscard]] DAXA_EXPORT_CXX auto to_string(ImageMemoryBarrierInfo const & info) -> std::string;
 
+    struct BufferMemoryBarrierInfo
+    {
+        Access src_access = AccessConsts::NONE;
+        Access dst_access = AccessConsts::NONE;
+        BufferId buffer_id = {};
+        u64 offset = {};
+        /// @brief  The default covers the rest of the buffer after offset.
+        u64 size = ~0ull;
+    };
+
+    [[nodiscard]] DAXA_EXPORT_CXX auto to_string(BufferMemoryBarrierInfo const & info) -> std::string;
+
     struct BinarySemaphoreInfo
     {
         SmallString name = {};
@@ -7,7 +7,10 @@
 #include <daxa/core.hpp>
 #include <daxa/device.hpp>
 
+#include <condition_variable>
 #include <deque>
+#include <mutex>
+#include <span>
 
 namespace daxa
 {
@@ -86,4 +89,92 @@ namespace daxa
         u32 claimed_start = {};
         u32 claimed_size = {};
     };
+
+    struct UploadEngineInfo
+    {
+        Device device = {};
+        // Queue the copies are submitted to. Images uploaded from a dedicated transfer queue must use concurrent sharing.
+        Queue queue = QUEUE_TRANSFER_0;
+        // Number of staging pools in the ring, each batch stages through one pool.
+        u32 pool_count = 3;
+        u32 pool_capacity = 1 << 25;
+        bool use_bar_memory = {};
+        std::string name = {};
+    };
+
+    struct UploadImageRegion
+    {
+        // Layout of the image while the copy executes, must be TRANSFER_DST_OPTIMAL or GENERAL.
+        ImageLayout image_layout = ImageLayout::TRANSFER_DST_OPTIMAL;
+        ImageArraySlice image_slice = {};
+        Offset3D image_offset = {};
+        Extent3D image_extent = {};
+    };
+
+    /// @brief  Timeline value of the upload engines timeline semaphore,
+    ///         it is signaled once the batch containing the upload finished on the gpu.
+    struct UploadTicket
+    {
+        u64 timeline_value = {};
+    };
+
+    /// @brief  Streams uploads from any thread through a ring of transfer memory pools into the transfer queue.
+    ///         Uploads are staged immediately and batched into one submit per flush.
+    ///         A batch is flushed explicitly or when its staging pool runs out of memory.
+    /// THREADSAFETY:
+    /// * all functions are internally synchronized.
+    /// * uploads into overlapping regions of the same resource within one batch are not ordered against each other.
+    struct UploadEngine
+    {
+        DAXA_EXPORT_CXX UploadEngine(UploadEngineInfo a_info);
+        UploadEngine(UploadEngine const &) = delete;
+        UploadEngine & operator=(UploadEngine const &) = delete;
+        DAXA_EXPORT_CXX ~UploadEngine();
+
+        /// @brief  Stages the data and adds a copy into the buffer at the given offset to the current batch.
+        ///         Uploads larger than half a pool are split into multiple copies, possibly over multiple batches.
+        /// @return ticket of the batch containing the last copy of the upload.
+        DAXA_EXPORT_CXX auto upload(BufferId dst_buffer, std::span<std::byte const> data, usize dst_offset = 0) -> UploadTicket;
+        /// @brief  Stages the tightly packed texel data and adds a copy into the image region to the current batch.
+        ///         Uploads larger than half a pool are split along array layers or depth slices, possibly over multiple batches.
+        /// @return ticket of the batch containing the last copy of the upload, nullopt if a single layer or depth slice does not fit into half a pool.
+        DAXA_EXPORT_CXX auto upload(ImageId dst_image, std::span<std::byte const> data, UploadImageRegion const & region) -> std::optional<UploadTicket>;
+        /// @brief  Records and submits all copies of the current batch.
+        /// @return ticket of the submitted batch, or of the last submitted batch if there was nothing to flush.
+        DAXA_EXPORT_CXX auto flush() -> UploadTicket;
+        // Returns true if the gpu finished all uploads of the ticket.
+        DAXA_EXPORT_CXX auto is_complete(UploadTicket ticket) const -> bool;
+        // Timeline semaphore to wait on for upload tickets, for example in the wait_timeline_semaphores of a graphics submit.
+        DAXA_EXPORT_CXX auto timeline_semaphore() const -> TimelineSemaphore const &;
+        /// THREADSAFETY:
+        /// * reference MUST NOT be read after the object is destroyed.
+        /// @return reference to info of object.
+        DAXA_EXPORT_CXX auto info() const -> UploadEngineInfo const &;
+
+      private:
+        struct StagingAllocation
+        {
+            TransferMemoryPool::Allocation allocation = {};
+            BufferId staging_buffer = {};
+            u64 batch_value = {};
+        };
+        // Allocates staging memory and registers a pending write, that blocks flushes until the copy is added.
+        DAXA_EXPORT_CXX auto stage(u32 size) -> StagingAllocation;
+        DAXA_EXPORT_CXX void add_copy(Variant<BufferCopyInfo, BufferImageCopyInfo> const & copy);
+        DAXA_EXPORT_CXX void flush_locked(std::unique_lock<std::mutex> & lock);
+
+        UploadEngineInfo m_info = {};
+        TimelineSemaphore gpu_timeline = {};
+        std::vector<TransferMemoryPool> pools = {};
+        // Pool timeline value signaled by the last batch staged through each pool.
+        std::vector<u64> pool_submit_values = {};
+        mutable std::mutex mtx = {};
+        std::condition_variable flush_cv = {};
+        std::vector<Variant<BufferCopyInfo, BufferImageCopyInfo>> pending_copies = {};
+        u32 pending_writes = {};
+        bool flushing = {};
+        usize current_pool = {};
+        // Engine timeline value the current batch signals.
+        u64 batch_value = 1;
+    };
 } // namespace daxa
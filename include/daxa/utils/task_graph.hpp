@@ -145,6 +145,7 @@ namespace daxa
         std::vector<TaskAttachmentInfo> attachments = {};
         std::function<void(TaskInterface)> task = {};
         char const * name = "unnamed";
+        Queue queue = QUEUE_MAIN;
     };
 
     struct InlineTask : ITask
@@ -157,6 +158,7 @@ namespace daxa
             value._internal._attachments = info.attachments;
             value._internal._callback = info.task;
             value._internal._name = info.name;
+            value._internal._queue = info.queue;
         }
         InlineTask(char const * name, TaskType task_type = TaskType::GENERAL)
         {
@@ -189,6 +191,7 @@ namespace daxa
             this->value._internal._callback = std::move(other.value._internal._callback);
             this->value._internal._name = std::move(other.value._internal._name);
             this->value._internal._task_type = std::move(other.value._internal._task_type);
+            this->value._internal._queue = other.value._internal._queue;
             other.value._internal._attachments = {};
             other.value._internal._callback = {};
             other.value._internal._name = {};
@@ -208,6 +211,7 @@ namespace daxa
             value._internal._callback(ti);
         }
         virtual auto task_type() const -> TaskType override { return value._internal._task_type; }
+        virtual auto queue() const -> Queue override { return value._internal._queue; }
 
       private:
         enum Allow
@@ -226,6 +230,7 @@ namespace daxa
             std::function<void(TaskInterface)> _callback = {};
             char const * _name = {};
             TaskType _task_type = TaskType::GENERAL;
+            Queue _queue = QUEUE_MAIN;
 
             void _process_params(TaskStage stage, TaskAccessType type, ImageViewType & view_override, TaskBufferBlasTlasViewOrBufferBlasTlas auto param)
             {
@@ -423,6 +428,11 @@ namespace daxa
             value._internal._callback = std::move(c);
             return std::move(*this);
         }
+        auto on_queue(Queue queue) && -> InlineTask
+        {
+            value._internal._queue = queue;
+            return std::move(*this);
+        }
 
       private:
         InlineTask(Internal && internal)
@@ -569,6 +579,17 @@ namespace daxa
                 constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> { return _attachments; }
                 constexpr virtual auto name() const -> std::string_view { return NoRefTTask::name(); }
                 virtual auto task_type() const -> TaskType { return _task.task_type(); };
+                virtual auto queue() const -> Queue
+                {
+                    if constexpr (requires { _task.queue(); })
+                    {
+                        return _task.queue();
+                    }
+                    else
+                    {
+                        return QUEUE_MAIN;
+                    }
+                };
                 virtual void callback(TaskInterface ti) { _task.callback(ti); };
             };
             auto wrapped_task = std::make_unique<WrapperTask>(std::move(task));
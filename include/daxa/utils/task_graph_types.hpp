@@ -1046,6 +1046,10 @@ namespace daxa
         constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> = 0;
         constexpr virtual auto task_type() const -> TaskType = 0;
         constexpr virtual std::string_view name() const = 0;
+        /// @brief  Queue the task is recorded for and submitted to.
+        ///         Tasks on different queues are separated into different submits, synchronized with timeline semaphores.
+        ///         Images accessed from multiple queue families must use concurrent sharing.
+        constexpr virtual auto queue() const -> Queue { return QUEUE_MAIN; }
         virtual void callback(TaskInterface){};
     };
 
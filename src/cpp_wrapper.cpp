@@ -7,12 +7,30 @@
 #include <utility>
 #include <format>
 #include <bit>
+#include <cstddef>
 
 #include "impl_device.hpp"
 #include "impl_instance.hpp"
 
 static_assert(sizeof(daxa::Queue) == sizeof(daxa_Queue));
 static_assert(alignof(daxa::Queue) == alignof(daxa_Queue));
+static_assert(sizeof(daxa::GarbageCollectBudget) == sizeof(daxa_GarbageCollectBudget));
+static_assert(alignof(daxa::GarbageCollectBudget) == alignof(daxa_GarbageCollectBudget));
+static_assert(sizeof(daxa::DeviceStats) == sizeof(daxa_DeviceStats));
+static_assert(sizeof(daxa::RenderPassInheritInfo) == sizeof(daxa_RenderPassInheritInfo));
+static_assert(sizeof(daxa::RenderPassBeginInfo) == sizeof(daxa_RenderPassBeginInfo));
+static_assert(alignof(daxa::DeviceStats) == alignof(daxa_DeviceStats));
+static_assert(sizeof(daxa::CommandRecorderInfo) == sizeof(daxa_CommandRecorderInfo));
+static_assert(sizeof(daxa::CommandRecorderStats) == sizeof(daxa_CommandRecorderStats));
+static_assert(sizeof(daxa::CommandSubmitInfo) == sizeof(daxa_CommandSubmitInfo));
+static_assert(alignof(daxa::CommandSubmitInfo) == alignof(daxa_CommandSubmitInfo));
+// submit_commands_batch reinterprets the C++ submit infos as C submit infos.
+static_assert(offsetof(daxa::CommandSubmitInfo, wait_binary_semaphore_stages) == offsetof(daxa_CommandSubmitInfo, wait_binary_semaphore_stages));
+static_assert(offsetof(daxa::CommandSubmitInfo, wait_timeline_semaphore_stages) == offsetof(daxa_CommandSubmitInfo, wait_timeline_semaphore_stages));
+static_assert(offsetof(daxa::CommandSubmitInfo, signal_timeline_semaphores) == offsetof(daxa_CommandSubmitInfo, signal_timeline_semaphores));
+static_assert(sizeof(daxa::PipelineStageFlags) == sizeof(VkPipelineStageFlags2));
+static_assert(sizeof(daxa::DrawIndexedInfo) == sizeof(daxa_DrawIndexedInfo));
+static_assert(sizeof(daxa::DispatchInfo) == sizeof(daxa_DispatchInfo));
 
 // --- Begin Helpers ---
 
@@ -138,6 +156,15 @@ auto daxa_result_to_string(daxa_Result result) -> std::string_view
         case DAXA_RESULT_ERROR_COMPUTE_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER: return "DAXA_RESULT_ERROR_COMPUTE_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER";
         case DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER: return "DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_TRANSFER_QUEUE_RECORDER";
         case DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_COMPUTE_QUEUE_RECORDER: return "DAXA_RESULT_ERROR_MAIN_FAMILY_CMD_ON_COMPUTE_QUEUE_RECORDER";
+        case DAXA_RESULT_ERROR_SECONDARY_CMD_LIST_SUBMITTED: return "DAXA_RESULT_ERROR_SECONDARY_CMD_LIST_SUBMITTED";
+        case DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_SECONDARY: return "DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_SECONDARY";
+        case DAXA_RESULT_ERROR_NOT_IN_SECONDARY_RENDERPASS: return "DAXA_RESULT_ERROR_NOT_IN_SECONDARY_RENDERPASS";
+        case DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_REUSABLE: return "DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_REUSABLE";
+        case DAXA_RESULT_ERROR_CMD_LIST_ALREADY_SUBMITTED: return "DAXA_RESULT_ERROR_CMD_LIST_ALREADY_SUBMITTED";
+        case DAXA_RESULT_ERROR_CMD_IN_SECONDARY_RENDERPASS: return "DAXA_RESULT_ERROR_CMD_IN_SECONDARY_RENDERPASS";
+        case DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_DEVICE_MISMATCH: return "DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_DEVICE_MISMATCH";
+        case DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_QUEUE_FAMILY_MISMATCH: return "DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_QUEUE_FAMILY_MISMATCH";
+        case DAXA_RESULT_ERROR_WAIT_STAGE_COUNT_MISMATCH: return "DAXA_RESULT_ERROR_WAIT_STAGE_COUNT_MISMATCH";
         case DAXA_RESULT_MAX_ENUM: return "DAXA_RESULT_MAX_ENUM";
     default: return "UNIMPLEMENTED CASE";
     }
@@ -269,6 +296,15 @@ namespace daxa
         check_result(result, "failed to create device memory report");
     }
 
+    auto Device::stats() const -> DeviceStats
+    {
+        DeviceStats ret = {};
+        check_result(
+            daxa_dvc_stats(r_cast<daxa_Device>(this->object), r_cast<daxa_DeviceStats *>(&ret)),
+            "failed to query device stats");
+        return ret;
+    }
+
     auto Device::device_memory_report_convenient() const -> DeviceMemoryReportConvenient
     {
         DeviceMemoryReportConvenient ret = {};
@@ -427,6 +463,23 @@ namespace daxa
     DAXA_DECL_GPU_RES_FN(Tlas, tlas)
     DAXA_DECL_GPU_RES_FN(Blas, blas)
 
+#define DAXA_DECL_GPU_RES_BATCHED_FN(Name, name)                                                                 \
+    void Device::create_##name##s(std::span<Name##Info const> infos, std::span<Name##Id> out_ids)                \
+    {                                                                                                            \
+        DAXA_DBG_ASSERT_TRUE_M(out_ids.size() >= infos.size(), "out_ids must be at least as large as infos");    \
+        check_result(                                                                                            \
+            daxa_dvc_create_##name##s(                                                                           \
+                r_cast<daxa_Device>(this->object),                                                               \
+                r_cast<daxa_##Name##Info const *>(infos.data()),                                                 \
+                r_cast<daxa_##Name##Id *>(out_ids.data()),                                                       \
+                static_cast<daxa_u32>(infos.size())),                                                            \
+            "failed to create " #name "s");                                                                      \
+    }
+
+    DAXA_DECL_GPU_RES_BATCHED_FN(Buffer, buffer)
+    DAXA_DECL_GPU_RES_BATCHED_FN(Image, image)
+    DAXA_DECL_GPU_RES_BATCHED_FN(ImageView, image_view)
+
     auto Device::buffer_device_address(BufferId id) const -> Optional<DeviceAddress>
     {
         DeviceAddress ret = 0;
@@ -552,15 +605,19 @@ namespace daxa
     {
         daxa_CommandSubmitInfo const c_submit_info = {
             .queue = std::bit_cast<daxa_Queue>(submit_info.queue),
-            .wait_stages = static_cast<VkPipelineStageFlags>(submit_info.wait_stages.data),
+            .wait_stages = static_cast<VkPipelineStageFlags2>(submit_info.wait_stages.data),
             .command_lists = reinterpret_cast<daxa_ExecutableCommandList const *>(submit_info.command_lists.data()),
             .command_list_count = submit_info.command_lists.size(),
             .wait_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.wait_binary_semaphores.data()),
             .wait_binary_semaphore_count = submit_info.wait_binary_semaphores.size(),
+            .wait_binary_semaphore_stages = reinterpret_cast<VkPipelineStageFlags2 const *>(submit_info.wait_binary_semaphore_stages.data()),
+            .wait_binary_semaphore_stage_count = submit_info.wait_binary_semaphore_stages.size(),
             .signal_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.signal_binary_semaphores.data()),
             .signal_binary_semaphore_count = submit_info.signal_binary_semaphores.size(),
             .wait_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.wait_timeline_semaphores.data()),
             .wait_timeline_semaphore_count = submit_info.wait_timeline_semaphores.size(),
+            .wait_timeline_semaphore_stages = reinterpret_cast<VkPipelineStageFlags2 const *>(submit_info.wait_timeline_semaphore_stages.data()),
+            .wait_timeline_semaphore_stage_count = submit_info.wait_timeline_semaphore_stages.size(),
             .signal_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.signal_timeline_semaphores.data()),
             .signal_timeline_semaphore_count = submit_info.signal_timeline_semaphores.size(),
         };
@@ -569,6 +626,13 @@ namespace daxa
             "failed to submit commands");
     }
 
+    void Device::submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos)
+    {
+        check_result(
+            daxa_dvc_submit_batch(r_cast<daxa_Device>(this->object), reinterpret_cast<daxa_CommandSubmitInfo const *>(submit_infos.data()), submit_infos.size()),
+            "failed to submit command batch");
+    }
+
     void Device::present_frame(PresentInfo const & info)
     {
         daxa_PresentInfo const c_present_info = {
@@ -588,6 +652,15 @@ namespace daxa
             "failed to collect garbage");
     }
 
+    auto Device::collect_garbage(GarbageCollectBudget const & budget) -> u64
+    {
+        u64 remaining_zombies = {};
+        check_result(
+            daxa_dvc_collect_garbage_budgeted(r_cast<daxa_Device>(this->object), r_cast<daxa_GarbageCollectBudget const *>(&budget), &remaining_zombies),
+            "failed to collect garbage");
+        return remaining_zombies;
+    }
+
     auto Device::properties() const -> DeviceProperties const &
     {
         return *r_cast<DeviceProperties const *>(daxa_dvc_properties(rc_cast<daxa_Device>(object)));
@@ -1052,6 +1125,15 @@ namespace daxa
     DAXA_DECL_RENDER_COMMAND_LIST_WRAPPER_CHECK_RESULT(set_index_buffer, SetIndexBufferInfo)
     DAXA_DECL_RENDER_COMMAND_LIST_WRAPPER(draw, DrawInfo)
     DAXA_DECL_RENDER_COMMAND_LIST_WRAPPER(draw_indexed, DrawIndexedInfo)
+
+    void RenderCommandRecorder::draw_indexed_multi(daxa::Span<DrawIndexedInfo const> const & infos)
+    {
+        daxa_cmd_draw_indexed_multi(
+            this->internal,
+            r_cast<daxa_DrawIndexedInfo const *>(infos.data()),
+            static_cast<u32>(infos.size()));
+    }
+
     DAXA_DECL_RENDER_COMMAND_LIST_WRAPPER_CHECK_RESULT(draw_indirect, DrawIndirectInfo)
     DAXA_DECL_RENDER_COMMAND_LIST_WRAPPER_CHECK_RESULT(draw_indirect_count, DrawIndirectCountInfo)
 
@@ -1080,6 +1162,34 @@ namespace daxa
         check_result(result, "failed in push_constant_vptr");
     }
 
+    auto RenderCommandRecorder::create_secondary(RenderPassInheritInfo const & info) -> RenderCommandRecorder
+    {
+        RenderCommandRecorder ret = {};
+        auto result = daxa_cmd_create_secondary(
+            this->internal,
+            r_cast<daxa_RenderPassInheritInfo const *>(&info),
+            &ret.internal);
+        check_result(result, "failed to create secondary command recorder");
+        return ret;
+    }
+
+    void RenderCommandRecorder::execute_commands(daxa::Span<ExecutableCommandList const> const & secondary_command_lists)
+    {
+        auto result = daxa_cmd_execute_commands(
+            this->internal,
+            reinterpret_cast<daxa_ExecutableCommandList const *>(secondary_command_lists.data()),
+            static_cast<u32>(secondary_command_lists.size()));
+        check_result(result, "failed to execute secondary commands");
+    }
+
+    auto RenderCommandRecorder::complete_current_commands() -> ExecutableCommandList
+    {
+        ExecutableCommandList ret = {};
+        auto result = daxa_cmd_complete_current_commands(this->internal, r_cast<daxa_ExecutableCommandList *>(&ret));
+        check_result(result, "failed to complete current commands");
+        return ret;
+    }
+
     /// --- End RenderCommandBuffer
 
     /// --- Begin CommandRecorder ---
@@ -1116,6 +1226,7 @@ namespace daxa
     }
     DAXA_DECL_COMMAND_LIST_WRAPPER(CommandRecorder, pipeline_barrier, MemoryBarrierInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(CommandRecorder, pipeline_barrier_image_transition, ImageMemoryBarrierInfo)
+    DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(CommandRecorder, pipeline_barrier_buffer, BufferMemoryBarrierInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER(CommandRecorder, signal_event, EventSignalInfo)
 
     void CommandRecorder::wait_events(daxa::Span<EventWaitInfo const> const & infos)
@@ -1164,6 +1275,15 @@ namespace daxa
         check_result(result, "failed in dispatch");
     }
 
+    void CommandRecorder::dispatch_multi(daxa::Span<DispatchInfo const> const & infos)
+    {
+        auto result = daxa_cmd_dispatch_multi(
+            this->internal,
+            r_cast<daxa_DispatchInfo const *>(infos.data()),
+            static_cast<u32>(infos.size()));
+        check_result(result, "failed in dispatch_multi");
+    }
+
     DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(CommandRecorder, dispatch_indirect, DispatchIndirectInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(CommandRecorder, trace_rays, TraceRaysInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(CommandRecorder, trace_rays_indirect, TraceRaysIndirectInfo)
@@ -1187,6 +1307,18 @@ namespace daxa
         this->internal = {};
         return ret;
     }
+
+    auto CommandRecorder::create_secondary(RenderPassInheritInfo const & info) -> RenderCommandRecorder
+    {
+        RenderCommandRecorder ret = {};
+        auto result = daxa_cmd_create_secondary(
+            this->internal,
+            r_cast<daxa_RenderPassInheritInfo const *>(&info),
+            &ret.internal);
+        check_result(result, "failed to create secondary command recorder");
+        return ret;
+    }
+
     DAXA_DECL_COMMAND_LIST_WRAPPER(CommandRecorder, write_timestamp, WriteTimestampInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER(CommandRecorder, reset_timestamps, ResetTimestampsInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER(CommandRecorder, begin_label, CommandLabelInfo)
@@ -1209,6 +1341,13 @@ namespace daxa
         return *r_cast<CommandRecorderInfo const *>(daxa_cmd_info(*rc_cast<daxa_CommandRecorder *>(this)));
     }
 
+    auto CommandRecorder::stats() const -> CommandRecorderStats
+    {
+        CommandRecorderStats ret = {};
+        daxa_cmd_stats(*rc_cast<daxa_CommandRecorder *>(this), r_cast<daxa_CommandRecorderStats *>(&ret));
+        return ret;
+    }
+
     CommandRecorder::~CommandRecorder()
     {
         if (this->internal != nullptr)
@@ -1254,6 +1393,16 @@ namespace daxa
                            to_string(info.image_id));
     }
 
+    auto to_string(BufferMemoryBarrierInfo const & info) -> std::string
+    {
+        return std::format("access: ({}) -> ({}), offset: {}, size: {}, id: {}",
+                           to_string(info.src_access),
+                           to_string(info.dst_access),
+                           info.offset,
+                           info.size,
+                           to_string(info.buffer_id));
+    }
+
     auto to_string(AccessTypeFlags flags) -> std::string
     {
         if (flags == AccessTypeFlagBits::NONE)
@@ -1,6 +1,8 @@
 #include "impl_command_recorder.hpp"
 
 #include <daxa/c/types.h>
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "impl_sync.hpp"
@@ -60,26 +62,33 @@ auto get_vk_memory_barrier(daxa_MemoryBarrierInfo const & memory_barrier) -> VkM
 }
 
 auto get_vk_dependency_info(
-    std::vector<VkImageMemoryBarrier2> const & vk_image_memory_barriers,
-    std::vector<VkMemoryBarrier2> const & vk_memory_barriers) -> VkDependencyInfo
+    VkImageMemoryBarrier2 const * vk_image_memory_barriers, usize vk_image_memory_barrier_count,
+    VkMemoryBarrier2 const * vk_memory_barriers, usize vk_memory_barrier_count) -> VkDependencyInfo
 {
     return VkDependencyInfo{
         .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
         .pNext = nullptr,
         .dependencyFlags = {},
-        .memoryBarrierCount = static_cast<u32>(vk_memory_barriers.size()),
-        .pMemoryBarriers = vk_memory_barriers.data(),
+        .memoryBarrierCount = static_cast<u32>(vk_memory_barrier_count),
+        .pMemoryBarriers = vk_memory_barriers,
         .bufferMemoryBarrierCount = 0,
         .pBufferMemoryBarriers = nullptr,
-        .imageMemoryBarrierCount = static_cast<u32>(vk_image_memory_barriers.size()),
-        .pImageMemoryBarriers = vk_image_memory_barriers.data(),
+        .imageMemoryBarrierCount = static_cast<u32>(vk_image_memory_barrier_count),
+        .pImageMemoryBarriers = vk_image_memory_barriers,
     };
 }
 
-auto CommandPoolPool::get(daxa_Device device) -> VkCommandPool
+void CommandPoolEntry::destroy(daxa_Device device)
 {
-    VkCommandPool pool = {};
-    if (pools_and_buffers.empty())
+    // Destroying the pool frees all its command buffers.
+    vkDestroyCommandPool(device->vk_device, this->vk_cmd_pool, nullptr);
+    *this = {};
+}
+
+auto CommandPoolPool::get(daxa_Device device) -> CommandPoolEntry
+{
+    CommandPoolEntry pool = {};
+    if (pools.empty())
     {
         VkCommandPoolCreateInfo const vk_command_pool_create_info{
             .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -88,28 +97,133 @@ auto CommandPoolPool::get(daxa_Device device) -> VkCommandPool
             .queueFamilyIndex = this->queue_family_index,
         };
 
-        vkCreateCommandPool(device->vk_device, &vk_command_pool_create_info, nullptr, &pool);
+        vkCreateCommandPool(device->vk_device, &vk_command_pool_create_info, nullptr, &pool.vk_cmd_pool);
     }
     else
     {
-        pool = pools_and_buffers.back();
-        pools_and_buffers.pop_back();
+        pool = std::move(pools.back());
+        pools.pop_back();
     }
     return pool;
 }
 
-void CommandPoolPool::put_back(VkCommandPool pool)
+void CommandPoolPool::put_back(CommandPoolEntry && pool)
 {
-    pools_and_buffers.push_back(pool);
+    pools.push_back(std::move(pool));
 }
 
 void CommandPoolPool::cleanup(daxa_Device device)
 {
-    for (auto * pool : pools_and_buffers)
+    for (auto & pool : pools)
+    {
+        pool.destroy(device);
+    }
+    pools.clear();
+}
+
+auto ThreadCommandPoolCache::try_push(daxa_QueueFamily queue_family, u64 timeline_value, CommandPoolEntry && pool) -> bool
+{
+    auto & family = this->families[queue_family];
+    if (family.count == MAX_RETIRED_POOLS_PER_FAMILY)
+    {
+        return false;
+    }
+    family.pools[(family.head + family.count) % MAX_RETIRED_POOLS_PER_FAMILY] = RetiredPool{
+        .timeline_value = timeline_value,
+        .pool = std::move(pool),
+    };
+    ++family.count;
+    return true;
+}
+
+auto ThreadCommandPoolCache::try_pop(daxa_Device device, daxa_QueueFamily queue_family, CommandPoolEntry & out_pool) -> daxa_Result
+{
+    auto & family = this->families[queue_family];
+    if (family.count == 0)
+    {
+        return DAXA_RESULT_NOT_READY;
+    }
+    auto & oldest = family.pools[family.head];
+    // Same condition as for all zombies, the pool may still be in use by the gpu otherwise.
+    if (oldest.timeline_value > device->finished_submit_timeline_value.load(std::memory_order_relaxed))
+    {
+        return DAXA_RESULT_NOT_READY;
+    }
+    auto result = static_cast<daxa_Result>(vkResetCommandPool(device->vk_device, oldest.pool.vk_cmd_pool, {}));
+    _DAXA_RETURN_IF_ERROR(result, result)
+    out_pool = std::move(oldest.pool);
+    family.head = (family.head + 1) % MAX_RETIRED_POOLS_PER_FAMILY;
+    --family.count;
+    return DAXA_RESULT_SUCCESS;
+}
+
+void ThreadCommandPoolCache::cleanup(daxa_Device device)
+{
+    for (auto & family : this->families)
     {
-        vkDestroyCommandPool(device->vk_device, pool, nullptr);
+        for (; family.count > 0; --family.count)
+        {
+            family.pools[family.head].pool.destroy(device);
+            family.head = (family.head + 1) % MAX_RETIRED_POOLS_PER_FAMILY;
+        }
     }
-    pools_and_buffers.clear();
+}
+
+auto RecorderEpochs::publish(u64 epoch) -> u32
+{
+    // Threads start searching in different places, so concurrent recorder creations rarely race for the same slot.
+    usize const start = ShardedCounter::thread_shard_index() * (SLOT_COUNT / ShardedCounter::SHARD_COUNT);
+    for (usize i = 0; i < SLOT_COUNT; ++i)
+    {
+        usize const slot = (start + i) % SLOT_COUNT;
+        u64 expected = 0;
+        if (this->slots[slot].load(std::memory_order_relaxed) == 0 &&
+            this->slots[slot].compare_exchange_strong(expected, epoch + 1, std::memory_order_seq_cst))
+        {
+            return static_cast<u32>(slot);
+        }
+    }
+    std::unique_lock const lock{this->overflow_mtx};
+    this->overflow_epochs.push_back(epoch);
+    this->overflow_count.fetch_add(1, std::memory_order_seq_cst);
+    return OVERFLOW_SLOT;
+}
+
+void RecorderEpochs::retire(u32 slot, u64 epoch)
+{
+    if (slot != OVERFLOW_SLOT)
+    {
+        this->slots[slot].store(0, std::memory_order_release);
+        return;
+    }
+    std::unique_lock const lock{this->overflow_mtx};
+    auto iter = std::find(this->overflow_epochs.begin(), this->overflow_epochs.end(), epoch);
+    DAXA_DBG_ASSERT_TRUE_M(iter != this->overflow_epochs.end(), "retired recorder epoch was never published");
+    *iter = this->overflow_epochs.back();
+    this->overflow_epochs.pop_back();
+    this->overflow_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+auto RecorderEpochs::oldest() -> u64
+{
+    u64 oldest_epoch = std::numeric_limits<u64>::max();
+    for (auto const & slot : this->slots)
+    {
+        u64 const value = slot.load(std::memory_order_seq_cst);
+        if (value != 0)
+        {
+            oldest_epoch = std::min(oldest_epoch, value - 1);
+        }
+    }
+    if (this->overflow_count.load(std::memory_order_seq_cst) != 0)
+    {
+        std::unique_lock const lock{this->overflow_mtx};
+        for (u64 const epoch : this->overflow_epochs)
+        {
+            oldest_epoch = std::min(oldest_epoch, epoch);
+        }
+    }
+    return oldest_epoch;
 }
 
 template <typename T>
@@ -185,32 +299,58 @@ auto only_check_blas(daxa_CommandRecorder self, T id) -> bool
     }
 }
 template <typename T>
-void remember_ids(daxa_CommandRecorder self, T id)
+void remember_ids([[maybe_unused]] daxa_CommandRecorder self, [[maybe_unused]] T id)
 {
+#if DAXA_TRACK_IDS
+    if (!self->track_ids)
+    {
+        return;
+    }
+    auto & data = self->current_command_data;
+    auto & used_ids = self->current_used_ids;
     if constexpr (std::is_same_v<daxa_BufferId, T>)
     {
-        self->current_command_data.used_buffers.push_back(std::bit_cast<BufferId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_BUFFER))
+        {
+            data.used_buffers.push_back(std::bit_cast<BufferId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_ImageId, T>)
     {
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_IMAGE))
+        {
+            data.used_images.push_back(std::bit_cast<ImageId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_ImageViewId, T>)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_IMAGE_VIEW))
+        {
+            data.used_image_views.push_back(std::bit_cast<ImageViewId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_SamplerId, T>)
     {
-        self->current_command_data.used_samplers.push_back(std::bit_cast<SamplerId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_SAMPLER))
+        {
+            data.used_samplers.push_back(std::bit_cast<SamplerId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_TlasId, T>)
     {
-        self->current_command_data.used_tlass.push_back(std::bit_cast<TlasId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_TLAS))
+        {
+            data.used_tlass.push_back(std::bit_cast<TlasId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_BlasId, T>)
     {
-        self->current_command_data.used_blass.push_back(std::bit_cast<BlasId>(id));
+        if (used_ids.insert(id.value, USED_ID_KIND_BLAS))
+        {
+            data.used_blass.push_back(std::bit_cast<BlasId>(id));
+        }
     }
+#endif
 }
 
 template <typename... Args>
@@ -263,6 +403,38 @@ void remember_ids(daxa_CommandRecorder self, Args... args)
     _DAXA_CHECK_IDS(__VA_ARGS__)         \
     _DAXA_REMEMBER_IDS(__VA_ARGS__)
 
+// Returns true if the bind can be dropped, as the pipeline is already bound.
+template <typename T>
+auto is_redundant_pipeline_bind(daxa_CommandRecorder self, T pipeline) -> bool
+{
+    if (self->info.filter_redundant_state == 0)
+    {
+        return false;
+    }
+    auto const * current = daxa::get_if<T>(&self->current_pipeline);
+    if (current == nullptr || *current != pipeline)
+    {
+        return false;
+    }
+    ++self->stats.elided_pipeline_binds;
+    return true;
+}
+
+// The table storage is reallocated when the buffer slots grow.
+// Called when a pipeline is set. Rebinds the descriptor buffer and returns true when the table grew since this recorder bound it last.
+inline auto rebind_descriptor_buffer_if_table_grown(daxa_CommandRecorder self) -> bool
+{
+    auto & table = self->device->gpu_sro_table;
+    u32 const generation = table.generation.load(std::memory_order_acquire);
+    if (generation == self->bound_table_generation)
+    {
+        return false;
+    }
+    self->bound_table_generation = generation;
+    table.bind_descriptor_buffer(self->current_command_data.vk_cmd_buffer);
+    return true;
+}
+
 /// --- End Helpers ---
 
 /// --- Begin API Functions ---
@@ -288,8 +460,8 @@ auto daxa_cmd_copy_buffer_to_buffer(daxa_CommandRecorder self, daxa_BufferCopyIn
     ImplBufferSlot const & src_slot = self->device->slot(info->src_buffer);
     ImplBufferSlot const & dst_slot = self->device->slot(info->dst_buffer);
     bool in_bounds = true;
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(src_slot.info.size));
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(dst_slot.info.size));
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= src_slot.size);
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= dst_slot.size);
     if (!in_bounds)
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS, DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS);
@@ -478,8 +650,7 @@ auto daxa_cmd_clear_buffer(daxa_CommandRecorder self, daxa_BufferClearInfo const
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->buffer)
-    ImplBufferSlot const & dst_slot = self->device->slot(info->buffer);
-    bool const in_bounds = ((static_cast<u64>(info->offset) + static_cast<u64>(info->size)) <= static_cast<u64>(dst_slot.info.size));
+    bool const in_bounds = ((static_cast<u64>(info->offset) + static_cast<u64>(info->size)) <= self->device->slot(info->buffer).size);
     if (!in_bounds)
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS, DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS);
@@ -499,9 +670,8 @@ auto daxa_cmd_clear_image(daxa_CommandRecorder self, daxa_ImageClearInfo const *
     daxa_cmd_flush_barriers(self);
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->image)
     auto const & img_slot = self->device->slot(info->image);
-    bool const is_image_depth_stencil =
-        is_depth_format(std::bit_cast<Format>(img_slot.info.format)) ||
-        is_stencil_format(std::bit_cast<Format>(img_slot.info.format));
+    // The aspect is inferred from the format on creation, so this avoids touching the cold image info.
+    bool const is_image_depth_stencil = (img_slot.aspect_flags & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0;
     bool const is_clear_depth_stencil = info->clear_value.index == 3;
     if (is_clear_depth_stencil)
     {
@@ -542,18 +712,17 @@ auto daxa_cmd_clear_image(daxa_CommandRecorder self, daxa_ImageClearInfo const *
 void daxa_cmd_pipeline_barrier(daxa_CommandRecorder self, daxa_MemoryBarrierInfo const * info)
 {
     PROFILE_FUNC();
-    if (self->memory_barrier_batch_count == COMMAND_LIST_BARRIER_MAX_BATCH_SIZE)
+    // Global memory barriers of one batch all apply at once, so they can be merged into a single barrier.
+    if (!self->has_memory_barrier_batch)
     {
-        daxa_cmd_flush_barriers(self);
+        self->memory_barrier_batch = get_vk_memory_barrier(*info);
+        self->has_memory_barrier_batch = true;
+        return;
     }
-    self->memory_barrier_batch.at(self->memory_barrier_batch_count++) = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
-        .pNext = nullptr,
-        .srcStageMask = info->src_access.stages,
-        .srcAccessMask = info->src_access.access_type,
-        .dstStageMask = info->dst_access.stages,
-        .dstAccessMask = info->dst_access.access_type,
-    };
+    self->memory_barrier_batch.srcStageMask |= info->src_access.stages;
+    self->memory_barrier_batch.srcAccessMask |= info->src_access.access_type;
+    self->memory_barrier_batch.dstStageMask |= info->dst_access.stages;
+    self->memory_barrier_batch.dstAccessMask |= info->dst_access.access_type;
 }
 
 /// @brief  Successive pipeline barrier calls are combined.
@@ -563,100 +732,125 @@ auto daxa_cmd_pipeline_barrier_image_transition(daxa_CommandRecorder self, daxa_
 {
     PROFILE_FUNC();
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->image_id)
-    if (self->image_barrier_batch_count == COMMAND_LIST_BARRIER_MAX_BATCH_SIZE)
+    auto const & img_slot = self->device->slot(info->image_id);
+    VkImageMemoryBarrier2 const vk_barrier = get_vk_image_memory_barrier(*info, img_slot.vk_image, img_slot.aspect_flags);
+    // Transitions of the same range between the same layouts are merged.
+    for (auto & batched : self->image_barrier_batch)
+    {
+        if (batched.image == vk_barrier.image &&
+            batched.oldLayout == vk_barrier.oldLayout &&
+            batched.newLayout == vk_barrier.newLayout &&
+            std::memcmp(&batched.subresourceRange, &vk_barrier.subresourceRange, sizeof(VkImageSubresourceRange)) == 0)
+        {
+            batched.srcStageMask |= vk_barrier.srcStageMask;
+            batched.srcAccessMask |= vk_barrier.srcAccessMask;
+            batched.dstStageMask |= vk_barrier.dstStageMask;
+            batched.dstAccessMask |= vk_barrier.dstAccessMask;
+            return DAXA_RESULT_SUCCESS;
+        }
+    }
+    self->image_barrier_batch.push_back(vk_barrier);
+    return DAXA_RESULT_SUCCESS;
+}
+
+/// @brief  Successive pipeline barrier calls are combined.
+///         As soon as a non-pipeline barrier command is recorded, the currently recorded barriers are flushed with a vkCmdPipelineBarrier2 call.
+/// @param info parameters.
+auto daxa_cmd_pipeline_barrier_buffer(daxa_CommandRecorder self, daxa_BufferMemoryBarrierInfo const * info) -> daxa_Result
+{
+    PROFILE_FUNC();
+    DAXA_CHECK_AND_REMEMBER_IDS(self, info->buffer_id)
+    VkBuffer const vk_buffer = self->device->slot(info->buffer_id).vk_buffer;
+    // Barriers on the same range are merged.
+    for (auto & batched : self->buffer_barrier_batch)
     {
-        daxa_cmd_flush_barriers(self);
+        if (batched.buffer == vk_buffer && batched.offset == info->offset && batched.size == info->size)
+        {
+            batched.srcStageMask |= info->src_access.stages;
+            batched.srcAccessMask |= info->src_access.access_type;
+            batched.dstStageMask |= info->dst_access.stages;
+            batched.dstAccessMask |= info->dst_access.access_type;
+            return DAXA_RESULT_SUCCESS;
+        }
     }
-    auto const & img_slot = self->device->slot(info->image_id);
-    self->image_barrier_batch.at(self->image_barrier_batch_count++) = {
-        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+    self->buffer_barrier_batch.push_back(VkBufferMemoryBarrier2{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
         .pNext = nullptr,
         .srcStageMask = info->src_access.stages,
         .srcAccessMask = info->src_access.access_type,
         .dstStageMask = info->dst_access.stages,
         .dstAccessMask = info->dst_access.access_type,
-        .oldLayout = static_cast<VkImageLayout>(info->src_layout),
-        .newLayout = static_cast<VkImageLayout>(info->dst_layout),
         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image = img_slot.vk_image,
-        .subresourceRange = make_subresource_range(info->image_slice, img_slot.aspect_flags),
-    };
+        .buffer = vk_buffer,
+        .offset = info->offset,
+        .size = info->size,
+    });
     return DAXA_RESULT_SUCCESS;
 }
-struct SplitBarrierDependencyInfoBuffer
-{
-    std::vector<VkImageMemoryBarrier2> vk_image_memory_barriers = {};
-    std::vector<VkMemoryBarrier2> vk_memory_barriers = {};
-};
-
-inline static thread_local std::vector<SplitBarrierDependencyInfoBuffer> tl_split_barrier_dependency_infos_aux_buffer = {}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-inline static thread_local std::vector<VkDependencyInfo> tl_split_barrier_dependency_infos_buffer = {};                     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-inline static thread_local std::vector<VkEvent> tl_split_barrier_events_buffer = {};
 
 void daxa_cmd_signal_event(daxa_CommandRecorder self, daxa_EventSignalInfo const * info)
 {
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
-    tl_split_barrier_dependency_infos_aux_buffer.push_back({});
-    auto & dependency_infos_aux_buffer = tl_split_barrier_dependency_infos_aux_buffer.back();
+    self->split_barrier_memory_barriers.clear();
+    self->split_barrier_image_barriers.clear();
     for (u64 i = 0; i < info->memory_barrier_count; ++i)
     {
-        auto const & memory_barrier = info->memory_barriers[i];
-        dependency_infos_aux_buffer.vk_memory_barriers.push_back(get_vk_memory_barrier(memory_barrier));
+        self->split_barrier_memory_barriers.push_back(get_vk_memory_barrier(info->memory_barriers[i]));
     }
     for (u64 i = 0; i < info->image_memory_barrier_count; ++i)
     {
         auto const & image_memory_barrier = info->image_memory_barriers[i];
-        dependency_infos_aux_buffer.vk_image_memory_barriers.push_back(
-            get_vk_image_memory_barrier(
-                image_memory_barrier,
-                self->device->slot(image_memory_barrier.image_id).vk_image,
-                self->device->slot(image_memory_barrier.image_id).aspect_flags));
+        auto const & img_slot = self->device->slot(image_memory_barrier.image_id);
+        self->split_barrier_image_barriers.push_back(get_vk_image_memory_barrier(image_memory_barrier, img_slot.vk_image, img_slot.aspect_flags));
     }
     VkDependencyInfo const vk_dependency_info = get_vk_dependency_info(
-        dependency_infos_aux_buffer.vk_image_memory_barriers,
-        dependency_infos_aux_buffer.vk_memory_barriers);
+        self->split_barrier_image_barriers.data(), self->split_barrier_image_barriers.size(),
+        self->split_barrier_memory_barriers.data(), self->split_barrier_memory_barriers.size());
     vkCmdSetEvent2(self->current_command_data.vk_cmd_buffer, (**info->event).vk_event, &vk_dependency_info);
-    tl_split_barrier_dependency_infos_aux_buffer.clear();
 }
 
 void daxa_cmd_wait_events(daxa_CommandRecorder self, daxa_EventWaitInfo const * infos, size_t info_count)
 {
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
+    self->split_barrier_memory_barriers.clear();
+    self->split_barrier_image_barriers.clear();
+    self->split_barrier_dependency_infos.clear();
+    self->split_barrier_events.clear();
+    // All barriers are gathered first, the dependency infos can only point into the arrays once they stopped growing.
     for (u64 i = 0; i < info_count; ++i)
     {
         auto const & end_info = infos[i];
-        tl_split_barrier_dependency_infos_aux_buffer.push_back({});
-        auto & dependency_infos_aux_buffer = tl_split_barrier_dependency_infos_aux_buffer.back();
         for (u64 j = 0; j < end_info.memory_barrier_count; ++j)
         {
-            auto const & memory_barrier = end_info.memory_barriers[j];
-            dependency_infos_aux_buffer.vk_memory_barriers.push_back(get_vk_memory_barrier(memory_barrier));
+            self->split_barrier_memory_barriers.push_back(get_vk_memory_barrier(end_info.memory_barriers[j]));
         }
         for (u64 j = 0; j < end_info.image_memory_barrier_count; ++j)
         {
             auto const & image_barrier = end_info.image_memory_barriers[j];
-            dependency_infos_aux_buffer.vk_image_memory_barriers.push_back(get_vk_image_memory_barrier(
-                image_barrier,
-                self->device->slot(image_barrier.image_id).vk_image,
-                self->device->slot(image_barrier.image_id).aspect_flags));
+            auto const & img_slot = self->device->slot(image_barrier.image_id);
+            self->split_barrier_image_barriers.push_back(get_vk_image_memory_barrier(image_barrier, img_slot.vk_image, img_slot.aspect_flags));
         }
-        tl_split_barrier_dependency_infos_buffer.push_back(get_vk_dependency_info(
-            dependency_infos_aux_buffer.vk_image_memory_barriers,
-            dependency_infos_aux_buffer.vk_memory_barriers));
-
-        tl_split_barrier_events_buffer.push_back((**end_info.event).vk_event);
+        self->split_barrier_events.push_back((**end_info.event).vk_event);
+    }
+    usize memory_barrier_offset = 0;
+    usize image_barrier_offset = 0;
+    for (u64 i = 0; i < info_count; ++i)
+    {
+        auto const & end_info = infos[i];
+        self->split_barrier_dependency_infos.push_back(get_vk_dependency_info(
+            self->split_barrier_image_barriers.data() + image_barrier_offset, end_info.image_memory_barrier_count,
+            self->split_barrier_memory_barriers.data() + memory_barrier_offset, end_info.memory_barrier_count));
+        memory_barrier_offset += end_info.memory_barrier_count;
+        image_barrier_offset += end_info.image_memory_barrier_count;
     }
     vkCmdWaitEvents2(
         self->current_command_data.vk_cmd_buffer,
-        static_cast<u32>(tl_split_barrier_events_buffer.size()),
-        tl_split_barrier_events_buffer.data(),
-        tl_split_barrier_dependency_infos_buffer.data());
-    tl_split_barrier_dependency_infos_aux_buffer.clear();
-    tl_split_barrier_dependency_infos_buffer.clear();
-    tl_split_barrier_events_buffer.clear();
+        static_cast<u32>(self->split_barrier_events.size()),
+        self->split_barrier_events.data(),
+        self->split_barrier_dependency_infos.data());
 }
 
 void daxa_cmd_wait_event(daxa_CommandRecorder self, daxa_EventWaitInfo const * info)
@@ -678,40 +872,30 @@ void daxa_cmd_reset_event(daxa_CommandRecorder self, daxa_ResetEventInfo const *
 auto daxa_cmd_push_constant(daxa_CommandRecorder self, daxa_PushConstantInfo const * info) -> daxa_Result
 {
     PROFILE_FUNC();
-    daxa_Result result = DAXA_RESULT_SUCCESS;
-    result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
-    _DAXA_RETURN_IF_ERROR(result, result);
-    daxa_cmd_flush_barriers(self);
-    if (daxa::holds_alternative<daxa_ImplCommandRecorder::NoPipeline>(self->current_pipeline))
+    // Pipelines can only be bound on queue families that allow push constants.
+    // Push constants are no action command, pending barriers do not have to be flushed for them.
+    if (self->current_pipeline_layout == VK_NULL_HANDLE)
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_NO_PIPELINE_BOUND, DAXA_RESULT_NO_PIPELINE_BOUND);
     }
-    VkPipelineLayout vk_pipeline_layout = {};
-    u32 current_pipeline_push_constant_size = {};
-    if (auto * pipeline = daxa::get_if<daxa_ComputePipeline>(&self->current_pipeline))
-    {
-        current_pipeline_push_constant_size = (**pipeline).info.push_constant_size;
-        vk_pipeline_layout = (**pipeline).vk_pipeline_layout;
-    }
-    if (auto * pipeline = daxa::get_if<daxa_RasterPipeline>(&self->current_pipeline))
-    {
-        current_pipeline_push_constant_size = (**pipeline).info.push_constant_size;
-        vk_pipeline_layout = (**pipeline).vk_pipeline_layout;
-    }
-    if (auto * pipeline = daxa::get_if<daxa_RayTracingPipeline>(&self->current_pipeline))
+    if (self->current_push_constant_size < info->size)
     {
-        current_pipeline_push_constant_size = (**pipeline).info.push_constant_size;
-        vk_pipeline_layout = (**pipeline).vk_pipeline_layout;
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_PUSHCONSTANT_RANGE_EXCEEDED, DAXA_RESULT_PUSHCONSTANT_RANGE_EXCEEDED);
     }
-    if (current_pipeline_push_constant_size < info->size)
+#if !DAXA_VALIDATION
+    // Vulkan requires push constant sizes to be a multiple of 4, other sizes take the padded path below.
+    if (info->size != 0 && (info->size & 0x3) == 0)
     {
-        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_PUSHCONSTANT_RANGE_EXCEEDED, DAXA_RESULT_PUSHCONSTANT_RANGE_EXCEEDED);
+        vkCmdPushConstants(self->current_command_data.vk_cmd_buffer, self->current_pipeline_layout, VK_SHADER_STAGE_ALL, 0, static_cast<u32>(info->size), info->data);
+        return DAXA_RESULT_SUCCESS;
     }
+#endif
     // Always write the whole range, fill with 0xFF to the size of the push constant.
     // This makes validation and renderdoc happy as well as help debug uninitialized push constant data
-    std::array<std::byte, DAXA_MAX_PUSH_CONSTANT_BYTE_SIZE> const_data = {std::byte{0xFF}};
+    std::array<std::byte, DAXA_MAX_PUSH_CONSTANT_BYTE_SIZE> const_data;
     std::memcpy(const_data.data(), info->data, info->size);
-    vkCmdPushConstants(self->current_command_data.vk_cmd_buffer, vk_pipeline_layout, VK_SHADER_STAGE_ALL, 0, current_pipeline_push_constant_size, const_data.data());
+    std::memset(const_data.data() + info->size, 0xFF, self->current_push_constant_size - info->size);
+    vkCmdPushConstants(self->current_command_data.vk_cmd_buffer, self->current_pipeline_layout, VK_SHADER_STAGE_ALL, 0, self->current_push_constant_size, const_data.data());
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -722,13 +906,20 @@ auto daxa_cmd_set_ray_tracing_pipeline(daxa_CommandRecorder self, daxa_RayTracin
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
     daxa_cmd_flush_barriers(self);
+    bool const table_grew = rebind_descriptor_buffer_if_table_grown(self);
+    if (!table_grew && is_redundant_pipeline_bind(self, pipeline))
+    {
+        return DAXA_RESULT_SUCCESS;
+    }
     bool const prev_pipeline_rt = self->current_pipeline.index() == decltype(self->current_pipeline)::index_of<daxa_RayTracingPipeline>;
     bool const same_type_same_layout_as_prev_pipe = prev_pipeline_rt && daxa::get<daxa_RayTracingPipeline>(self->current_pipeline)->vk_pipeline_layout == pipeline->vk_pipeline_layout;
-    if (!same_type_same_layout_as_prev_pipe)
+    if (!same_type_same_layout_as_prev_pipe || table_grew)
     {
-        vkCmdBindDescriptorSets(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline->vk_pipeline_layout, 0, 1, &self->device->gpu_sro_table.vk_descriptor_set, 0, nullptr);
+        self->device->gpu_sro_table.bind(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline->vk_pipeline_layout);
     }
     self->current_pipeline = pipeline;
+    self->current_pipeline_layout = pipeline->vk_pipeline_layout;
+    self->current_push_constant_size = pipeline->info.push_constant_size;
     vkCmdBindPipeline(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, pipeline->vk_pipeline);
     return DAXA_RESULT_SUCCESS;
 }
@@ -740,13 +931,20 @@ auto daxa_cmd_set_compute_pipeline(daxa_CommandRecorder self, daxa_ComputePipeli
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
     daxa_cmd_flush_barriers(self);
+    bool const table_grew = rebind_descriptor_buffer_if_table_grown(self);
+    if (!table_grew && is_redundant_pipeline_bind(self, pipeline))
+    {
+        return DAXA_RESULT_SUCCESS;
+    }
     bool const prev_pipeline_compute = self->current_pipeline.index() == decltype(self->current_pipeline)::index_of<daxa_ComputePipeline>;
     bool const same_type_same_layout_as_prev_pipe = prev_pipeline_compute && daxa::get<daxa_ComputePipeline>(self->current_pipeline)->vk_pipeline_layout == pipeline->vk_pipeline_layout;
-    if (!same_type_same_layout_as_prev_pipe)
+    if (!same_type_same_layout_as_prev_pipe || table_grew)
     {
-        vkCmdBindDescriptorSets(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->vk_pipeline_layout, 0, 1, &self->device->gpu_sro_table.vk_descriptor_set, 0, nullptr);
+        self->device->gpu_sro_table.bind(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->vk_pipeline_layout);
     }
     self->current_pipeline = pipeline;
+    self->current_pipeline_layout = pipeline->vk_pipeline_layout;
+    self->current_push_constant_size = pipeline->info.push_constant_size;
     vkCmdBindPipeline(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->vk_pipeline);
     return DAXA_RESULT_SUCCESS;
 }
@@ -757,14 +955,29 @@ auto daxa_cmd_set_raster_pipeline(daxa_CommandRecorder self, daxa_RasterPipeline
     daxa_Result result = DAXA_RESULT_SUCCESS;
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_MAIN);
     _DAXA_RETURN_IF_ERROR(result, result);
+#if DAXA_VALIDATION
+    // Renderpasses executing secondaries may only contain daxa_cmd_execute_commands, draws and state are recorded by the secondaries.
+    // Checked once per pipeline, as draws without a pipeline are invalid anyway.
+    if (self->in_secondary_renderpass)
+    {
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_IN_SECONDARY_RENDERPASS, DAXA_RESULT_ERROR_CMD_IN_SECONDARY_RENDERPASS);
+    }
+#endif
     daxa_cmd_flush_barriers(self);
+    bool const table_grew = rebind_descriptor_buffer_if_table_grown(self);
+    if (!table_grew && is_redundant_pipeline_bind(self, pipeline))
+    {
+        return DAXA_RESULT_SUCCESS;
+    }
     bool const prev_pipeline_raster = self->current_pipeline.index() == decltype(self->current_pipeline)::index_of<daxa_RasterPipeline>;
     bool const same_type_same_layout_as_prev_pipe = prev_pipeline_raster && daxa::get<daxa_RasterPipeline>(self->current_pipeline)->vk_pipeline_layout == pipeline->vk_pipeline_layout;
-    if (!same_type_same_layout_as_prev_pipe)
+    if (!same_type_same_layout_as_prev_pipe || table_grew)
     {
-        vkCmdBindDescriptorSets(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->vk_pipeline_layout, 0, 1, &self->device->gpu_sro_table.vk_descriptor_set, 0, nullptr);
+        self->device->gpu_sro_table.bind(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->vk_pipeline_layout);
     }
     self->current_pipeline = pipeline;
+    self->current_pipeline_layout = pipeline->vk_pipeline_layout;
+    self->current_push_constant_size = pipeline->info.push_constant_size;
     vkCmdBindPipeline(self->current_command_data.vk_cmd_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->vk_pipeline);
     return DAXA_RESULT_SUCCESS;
 }
@@ -775,6 +988,7 @@ auto daxa_cmd_trace_rays(daxa_CommandRecorder self, daxa_TraceRaysInfo const * i
     daxa_Result result = DAXA_RESULT_SUCCESS;
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_cmd_flush_barriers(self);
     // TODO: Check if those offsets are in range?
     if (!daxa::holds_alternative<daxa_RayTracingPipeline>(self->current_pipeline))
     {
@@ -805,6 +1019,7 @@ auto daxa_cmd_trace_rays_indirect(daxa_CommandRecorder self, daxa_TraceRaysIndir
     daxa_Result result = DAXA_RESULT_SUCCESS;
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_cmd_flush_barriers(self);
     // TODO: Check if those offsets are in range?
     if (!daxa::holds_alternative<daxa_RayTracingPipeline>(self->current_pipeline))
     {
@@ -835,6 +1050,7 @@ auto daxa_cmd_dispatch(daxa_CommandRecorder self, daxa_DispatchInfo const * info
     daxa_Result result = DAXA_RESULT_SUCCESS;
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_cmd_flush_barriers(self);
     // TODO: Check if those offsets are in range?
     if (!daxa::holds_alternative<daxa_ComputePipeline>(self->current_pipeline))
     {
@@ -844,12 +1060,33 @@ auto daxa_cmd_dispatch(daxa_CommandRecorder self, daxa_DispatchInfo const * info
     return DAXA_RESULT_SUCCESS;
 }
 
+auto daxa_cmd_dispatch_multi(daxa_CommandRecorder self, daxa_DispatchInfo const * infos, u32 count) -> daxa_Result
+{
+    PROFILE_FUNC();
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
+    _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_cmd_flush_barriers(self);
+    if (!daxa::holds_alternative<daxa_ComputePipeline>(self->current_pipeline))
+    {
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_NO_COMPUTE_PIPELINE_BOUND, DAXA_RESULT_NO_COMPUTE_PIPELINE_BOUND);
+    }
+    // Validated once for all dispatches.
+    VkCommandBuffer const vk_cmd_buffer = self->current_command_data.vk_cmd_buffer;
+    for (u32 i = 0; i < count; ++i)
+    {
+        vkCmdDispatch(vk_cmd_buffer, infos[i].x, infos[i].y, infos[i].z);
+    }
+    return DAXA_RESULT_SUCCESS;
+}
+
 auto daxa_cmd_dispatch_indirect(daxa_CommandRecorder self, daxa_DispatchIndirectInfo const * info) -> daxa_Result
 {
     PROFILE_FUNC();
     daxa_Result result = DAXA_RESULT_SUCCESS;
     result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_COMPUTE);
     _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_cmd_flush_barriers(self);
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->indirect_buffer)
     if (!daxa::holds_alternative<daxa_ComputePipeline>(self->current_pipeline))
     {
@@ -928,7 +1165,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_INVALID_IMAGE_VIEW_ID);
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->color_attachments.data[i].image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->color_attachments.data[i].image_view).image) == 0)
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_ID, DAXA_RESULT_INVALID_IMAGE_ID);
         }
@@ -941,7 +1178,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_INVALID_IMAGE_VIEW_ID);
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->depth_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->depth_attachment.value.image_view).image) == 0)
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_ID, DAXA_RESULT_INVALID_IMAGE_ID);
         }
@@ -954,7 +1191,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_INVALID_IMAGE_VIEW_ID);
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->stencil_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->stencil_attachment.value.image_view).image) == 0)
         {
             _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_ID, DAXA_RESULT_INVALID_IMAGE_ID);
         }
@@ -962,24 +1199,21 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
     };
     for (usize i = 0; i < info->color_attachments.size; ++i)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->color_attachments.data[i].image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->color_attachments.data[i].image_view).info.image));
+        remember_ids(self, info->color_attachments.data[i].image_view, self->device->slot(info->color_attachments.data[i].image_view).image);
     }
     if (info->depth_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->depth_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->depth_attachment.value.image_view).info.image));
+        remember_ids(self, info->depth_attachment.value.image_view, self->device->slot(info->depth_attachment.value.image_view).image);
     }
     if (info->stencil_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->stencil_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->stencil_attachment.value.image_view).info.image));
+        remember_ids(self, info->stencil_attachment.value.image_view, self->device->slot(info->stencil_attachment.value.image_view).image);
     }
 
     VkRenderingInfo const vk_rendering_info{
         .sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR,
         .pNext = nullptr,
-        .flags = {},
+        .flags = info->secondary_command_lists != 0 ? static_cast<VkRenderingFlags>(VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT) : VkRenderingFlags{},
         .renderArea = info->render_area,
         .layerCount = 1,
         .viewMask = {},
@@ -998,8 +1232,14 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         .maxDepth = 1.0f,
     };
     vkCmdSetViewport(self->current_command_data.vk_cmd_buffer, 0, 1, &vk_viewport);
+    self->state_cache.has_scissor = true;
+    self->state_cache.scissor = info->render_area;
+    self->state_cache.has_viewport = true;
+    self->state_cache.viewport = vk_viewport;
     vkCmdBeginRendering(self->current_command_data.vk_cmd_buffer, &vk_rendering_info);
-    if (self->device->vkCmdSetRasterizationSamplesEXT != nullptr)
+    self->in_secondary_renderpass = info->secondary_command_lists != 0;
+    // Renderpasses executing secondaries may only contain vkCmdExecuteCommands, the secondaries set their own state.
+    if (self->device->vkCmdSetRasterizationSamplesEXT != nullptr && !self->in_secondary_renderpass)
     {
         self->device->vkCmdSetRasterizationSamplesEXT(self->current_command_data.vk_cmd_buffer, VK_SAMPLE_COUNT_1_BIT);
     }
@@ -1010,15 +1250,133 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
 void daxa_cmd_end_renderpass(daxa_CommandRecorder self)
 {
     PROFILE_FUNC();
+#if DAXA_VALIDATION
+    DAXA_DBG_ASSERT_TRUE_M(!self->is_secondary, "secondary command recorders can not end the renderpass of their primary");
+#endif
     daxa_cmd_flush_barriers(self);
     vkCmdEndRendering(self->current_command_data.vk_cmd_buffer);
     self->in_renderpass = false;
+    self->in_secondary_renderpass = false;
+}
+
+auto daxa_cmd_create_secondary(daxa_CommandRecorder self, daxa_RenderPassInheritInfo const * info, daxa_CommandRecorder * out_secondary) -> daxa_Result
+{
+    PROFILE_FUNC();
+    daxa_Result result = validate_queue_family(self->info.queue_family, DAXA_QUEUE_FAMILY_MAIN);
+    _DAXA_RETURN_IF_ERROR(result, result);
+    daxa_CommandRecorderInfo const secondary_info = {
+        .queue_family = self->info.queue_family,
+        .name = info->name,
+        .reusable_command_lists = self->info.reusable_command_lists,
+        .filter_redundant_state = self->info.filter_redundant_state,
+    };
+    return create_command_recorder_helper(self->device, &secondary_info, info, out_secondary);
+}
+
+auto daxa_cmd_execute_commands(daxa_CommandRecorder self, daxa_ExecutableCommandList const * secondary_cmd_lists, u32 count) -> daxa_Result
+{
+    PROFILE_FUNC();
+    if (!self->in_secondary_renderpass)
+    {
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_NOT_IN_SECONDARY_RENDERPASS, DAXA_RESULT_ERROR_NOT_IN_SECONDARY_RENDERPASS);
+    }
+    for (daxa_ExecutableCommandList secondary : std::span{secondary_cmd_lists, count})
+    {
+        if (!secondary->cmd_recorder->is_secondary)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_SECONDARY, DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_SECONDARY);
+        }
+        // Secondaries must come from the same device and queue family, their pools and ids are only valid there.
+        if (secondary->cmd_recorder->device != self->device)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_DEVICE_MISMATCH, DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_DEVICE_MISMATCH);
+        }
+        if (secondary->cmd_recorder->info.queue_family != self->info.queue_family)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_QUEUE_FAMILY_MISMATCH);
+        }
+        // One time submit secondaries become invalid after the first submit of the primary.
+        if (self->info.reusable_command_lists != 0 && secondary->cmd_recorder->info.reusable_command_lists == 0)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_REUSABLE, DAXA_RESULT_ERROR_EXECUTED_CMD_LIST_IS_NOT_REUSABLE);
+        }
+    }
+    // Barriers recorded before must execute before the secondaries, the secondaries flushed their own barriers on completion.
+    daxa_cmd_flush_barriers(self);
+
+    std::array<VkCommandBuffer, 32> vk_cmd_buffers = {};
+    u32 vk_cmd_buffer_count = {};
+    for (daxa_ExecutableCommandList secondary : std::span{secondary_cmd_lists, count})
+    {
+        vk_cmd_buffers[vk_cmd_buffer_count++] = secondary->data.vk_cmd_buffer;
+        if (vk_cmd_buffer_count == vk_cmd_buffers.size())
+        {
+            vkCmdExecuteCommands(self->current_command_data.vk_cmd_buffer, vk_cmd_buffer_count, vk_cmd_buffers.data());
+            vk_cmd_buffer_count = 0;
+        }
+
+        // Merge tracking into the primary, submit validates and destroys for the secondaries.
+        auto & data = secondary->data;
+        for (BufferId id : data.used_buffers)
+        {
+            remember_ids(self, std::bit_cast<daxa_BufferId>(id));
+        }
+        for (ImageId id : data.used_images)
+        {
+            remember_ids(self, std::bit_cast<daxa_ImageId>(id));
+        }
+        for (ImageViewId id : data.used_image_views)
+        {
+            remember_ids(self, std::bit_cast<daxa_ImageViewId>(id));
+        }
+        for (SamplerId id : data.used_samplers)
+        {
+            remember_ids(self, std::bit_cast<daxa_SamplerId>(id));
+        }
+        for (TlasId id : data.used_tlass)
+        {
+            remember_ids(self, std::bit_cast<daxa_TlasId>(id));
+        }
+        for (BlasId id : data.used_blass)
+        {
+            remember_ids(self, std::bit_cast<daxa_BlasId>(id));
+        }
+        self->current_command_data.deferred_destructions.insert(
+            self->current_command_data.deferred_destructions.end(),
+            data.deferred_destructions.begin(),
+            data.deferred_destructions.end());
+        data.deferred_destructions.clear();
+
+        [[maybe_unused]] u64 const _ignore = daxa_executable_commands_inc_refcnt(secondary);
+        self->current_command_data.executed_secondaries.push_back(secondary);
+    }
+    if (vk_cmd_buffer_count != 0)
+    {
+        vkCmdExecuteCommands(self->current_command_data.vk_cmd_buffer, vk_cmd_buffer_count, vk_cmd_buffers.data());
+    }
+    // Executing secondaries leaves all state of the primary undefined.
+    self->current_pipeline = daxa_ImplCommandRecorder::NoPipeline{};
+    self->current_pipeline_layout = VK_NULL_HANDLE;
+    self->state_cache = {};
+    // Forces a rebind of the descriptor buffer with the next pipeline set.
+    self->bound_table_generation = ~0u;
+    return DAXA_RESULT_SUCCESS;
 }
 
 void daxa_cmd_set_viewport(daxa_CommandRecorder self, VkViewport const * info)
 {
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
+    if (self->info.filter_redundant_state != 0)
+    {
+        if (self->state_cache.has_viewport && std::memcmp(&self->state_cache.viewport, info, sizeof(VkViewport)) == 0)
+        {
+            ++self->stats.elided_viewports;
+            return;
+        }
+        self->state_cache.has_viewport = true;
+        self->state_cache.viewport = *info;
+    }
     vkCmdSetViewport(self->current_command_data.vk_cmd_buffer, 0, 1, info);
 }
 
@@ -1026,6 +1384,16 @@ void daxa_cmd_set_scissor(daxa_CommandRecorder self, VkRect2D const * info)
 {
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
+    if (self->info.filter_redundant_state != 0)
+    {
+        if (self->state_cache.has_scissor && std::memcmp(&self->state_cache.scissor, info, sizeof(VkRect2D)) == 0)
+        {
+            ++self->stats.elided_scissors;
+            return;
+        }
+        self->state_cache.has_scissor = true;
+        self->state_cache.scissor = *info;
+    }
     vkCmdSetScissor(self->current_command_data.vk_cmd_buffer, 0, 1, info);
 }
 
@@ -1033,6 +1401,16 @@ void daxa_cmd_set_depth_bias(daxa_CommandRecorder self, daxa_DepthBiasInfo const
 {
     PROFILE_FUNC();
     daxa_cmd_flush_barriers(self);
+    if (self->info.filter_redundant_state != 0)
+    {
+        if (self->state_cache.has_depth_bias && std::memcmp(&self->state_cache.depth_bias, info, sizeof(daxa_DepthBiasInfo)) == 0)
+        {
+            ++self->stats.elided_depth_biases;
+            return;
+        }
+        self->state_cache.has_depth_bias = true;
+        self->state_cache.depth_bias = *info;
+    }
     vkCmdSetDepthBias(self->current_command_data.vk_cmd_buffer, info->constant_factor, info->clamp, info->slope_factor);
 }
 
@@ -1040,7 +1418,21 @@ auto daxa_cmd_set_index_buffer(daxa_CommandRecorder self, daxa_SetIndexBufferInf
 {
     PROFILE_FUNC();
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->buffer)
-    vkCmdBindIndexBuffer(self->current_command_data.vk_cmd_buffer, self->device->slot(info->buffer).vk_buffer, info->offset, info->index_type);
+    VkBuffer const vk_buffer = self->device->slot(info->buffer).vk_buffer;
+    if (self->info.filter_redundant_state != 0)
+    {
+        if (self->state_cache.index_buffer == vk_buffer &&
+            self->state_cache.index_buffer_offset == info->offset &&
+            self->state_cache.index_type == info->index_type)
+        {
+            ++self->stats.elided_index_buffer_binds;
+            return DAXA_RESULT_SUCCESS;
+        }
+        self->state_cache.index_buffer = vk_buffer;
+        self->state_cache.index_buffer_offset = info->offset;
+        self->state_cache.index_type = info->index_type;
+    }
+    vkCmdBindIndexBuffer(self->current_command_data.vk_cmd_buffer, vk_buffer, info->offset, info->index_type);
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -1056,6 +1448,51 @@ void daxa_cmd_draw_indexed(daxa_CommandRecorder self, daxa_DrawIndexedInfo const
     vkCmdDrawIndexed(self->current_command_data.vk_cmd_buffer, info->index_count, info->instance_count, info->first_index, info->vertex_offset, info->first_instance);
 }
 
+void daxa_cmd_draw_indexed_multi(daxa_CommandRecorder self, daxa_DrawIndexedInfo const * infos, u32 count)
+{
+    PROFILE_FUNC();
+    VkCommandBuffer const vk_cmd_buffer = self->current_command_data.vk_cmd_buffer;
+    if (self->device->vkCmdDrawMultiIndexedEXT == nullptr)
+    {
+        for (u32 i = 0; i < count; ++i)
+        {
+            vkCmdDrawIndexed(vk_cmd_buffer, infos[i].index_count, infos[i].instance_count, infos[i].first_index, infos[i].vertex_offset, infos[i].first_instance);
+        }
+        return;
+    }
+    // A multi draw shares instance count and first instance, so each run of draws that agree on them becomes one call.
+    auto & multi_draw_infos = self->multi_draw_indexed_infos;
+    u32 run_start = 0;
+    while (run_start < count)
+    {
+        u32 const instance_count = infos[run_start].instance_count;
+        u32 const first_instance = infos[run_start].first_instance;
+        multi_draw_infos.clear();
+        u32 run_end = run_start;
+        while (run_end < count &&
+               infos[run_end].instance_count == instance_count &&
+               infos[run_end].first_instance == first_instance &&
+               multi_draw_infos.size() < COMMAND_LIST_MULTI_DRAW_MAX_BATCH_SIZE)
+        {
+            multi_draw_infos.push_back(VkMultiDrawIndexedInfoEXT{
+                .firstIndex = infos[run_end].first_index,
+                .indexCount = infos[run_end].index_count,
+                .vertexOffset = infos[run_end].vertex_offset,
+            });
+            ++run_end;
+        }
+        self->device->vkCmdDrawMultiIndexedEXT(
+            vk_cmd_buffer,
+            static_cast<u32>(multi_draw_infos.size()),
+            multi_draw_infos.data(),
+            instance_count,
+            first_instance,
+            sizeof(VkMultiDrawIndexedInfoEXT),
+            nullptr);
+        run_start = run_end;
+    }
+}
+
 auto daxa_cmd_draw_indirect(daxa_CommandRecorder self, daxa_DrawIndirectInfo const * info) -> daxa_Result
 {
     PROFILE_FUNC();
@@ -1211,29 +1648,39 @@ void daxa_cmd_end_label(daxa_CommandRecorder self)
 void daxa_cmd_reset_assumed_state(daxa_CommandRecorder self)
 {
     self->current_pipeline = daxa_ImplCommandRecorder::NoPipeline{};
+    self->current_pipeline_layout = VK_NULL_HANDLE;
+    // Externally recorded commands may have changed dynamic state and the index buffer.
+    self->state_cache = {};
+    // Externally recorded commands may have bound other descriptor buffers.
+    if (self->info.queue_family != DAXA_QUEUE_FAMILY_TRANSFER)
+    {
+        self->bound_table_generation = self->device->gpu_sro_table.generation.load(std::memory_order_acquire);
+        self->device->gpu_sro_table.bind_descriptor_buffer(self->current_command_data.vk_cmd_buffer);
+    }
 }
 
 void daxa_cmd_flush_barriers(daxa_CommandRecorder self)
 {
-    if (self->memory_barrier_batch_count > 0 || self->image_barrier_batch_count > 0)
+    if (self->has_memory_barrier_batch || !self->image_barrier_batch.empty() || !self->buffer_barrier_batch.empty())
     {
         PROFILE_FUNC();
         VkDependencyInfo const vk_dependency_info{
             .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
             .pNext = nullptr,
             .dependencyFlags = {},
-            .memoryBarrierCount = static_cast<u32>(self->memory_barrier_batch_count),
-            .pMemoryBarriers = self->memory_barrier_batch.data(),
-            .bufferMemoryBarrierCount = 0,
-            .pBufferMemoryBarriers = nullptr,
-            .imageMemoryBarrierCount = static_cast<u32>(self->image_barrier_batch_count),
+            .memoryBarrierCount = self->has_memory_barrier_batch ? 1u : 0u,
+            .pMemoryBarriers = &self->memory_barrier_batch,
+            .bufferMemoryBarrierCount = static_cast<u32>(self->buffer_barrier_batch.size()),
+            .pBufferMemoryBarriers = self->buffer_barrier_batch.data(),
+            .imageMemoryBarrierCount = static_cast<u32>(self->image_barrier_batch.size()),
             .pImageMemoryBarriers = self->image_barrier_batch.data(),
         };
 
         vkCmdPipelineBarrier2(self->current_command_data.vk_cmd_buffer, &vk_dependency_info);
 
-        self->memory_barrier_batch_count = 0;
-        self->image_barrier_batch_count = 0;
+        self->has_memory_barrier_batch = false;
+        self->image_barrier_batch.clear();
+        self->buffer_barrier_batch.clear();
     }
 }
 
@@ -1260,6 +1707,7 @@ auto daxa_cmd_complete_current_commands(
         .data = std::move(cmd_data),
     };
     self->current_pipeline = daxa_ImplCommandRecorder::NoPipeline{};
+    self->current_pipeline_layout = VK_NULL_HANDLE;
     self->inc_refcnt();
     return DAXA_RESULT_SUCCESS;
 }
@@ -1269,6 +1717,11 @@ auto daxa_cmd_info(daxa_CommandRecorder self) -> daxa_CommandRecorderInfo const
     return &self->info;
 }
 
+void daxa_cmd_stats(daxa_CommandRecorder self, daxa_CommandRecorderStats * out_stats)
+{
+    *out_stats = self->stats;
+}
+
 auto daxa_cmd_get_vk_command_buffer(daxa_CommandRecorder self) -> VkCommandBuffer
 {
     return self->current_command_data.vk_cmd_buffer;
@@ -1276,58 +1729,82 @@ auto daxa_cmd_get_vk_command_buffer(daxa_CommandRecorder self) -> VkCommandBuffe
 
 auto daxa_cmd_get_vk_command_pool(daxa_CommandRecorder self) -> VkCommandPool
 {
-    return self->vk_cmd_pool;
+    return self->pool.vk_cmd_pool;
 }
 
 void daxa_destroy_command_recorder(daxa_CommandRecorder self)
 {
     PROFILE_FUNC();
-    self->device->gpu_sro_table.lifetime_lock.unlock_shared();
+    self->device->recorder_epochs.retire(self->epoch_slot, self->epoch);
+    // Zombies held back by this recorder may be collectable now.
+    self->device->notify_garbage_collector();
     self->dec_refcnt(
         daxa_ImplCommandRecorder::zero_ref_callback,
         self->device->instance);
 }
 
-auto daxa_dvc_create_command_recorder(daxa_Device device, daxa_CommandRecorderInfo const * info, daxa_CommandRecorder * out_cmd_list) -> daxa_Result
+auto create_command_recorder_helper(daxa_Device device, daxa_CommandRecorderInfo const * info, daxa_RenderPassInheritInfo const * opt_inherit_info, daxa_CommandRecorder * out_cmd_list) -> daxa_Result
 {
-    PROFILE_FUNC();
-    VkCommandPool vk_cmd_pool = [&]()
+    auto * ret = new daxa_ImplCommandRecorder{};
+    ret->device = device;
+    ret->info = *info;
+    ret->track_ids = device->info.disable_id_tracking == 0;
+    if (opt_inherit_info != nullptr)
+    {
+        ret->is_secondary = true;
+        ret->inherit_info = *opt_inherit_info;
+    }
+    // Pools of recorders that died on this thread are reused first, that needs no synchronization.
+    ThreadCommandPoolCache * thread_cache = device->thread_command_pool_cache();
+    auto result = thread_cache != nullptr ? thread_cache->try_pop(device, info->queue_family, ret->pool) : DAXA_RESULT_NOT_READY;
+    if (result == DAXA_RESULT_NOT_READY)
     {
         std::unique_lock lock{device->command_pool_pools[info->queue_family].mtx};
-        return device->command_pool_pools[info->queue_family].get(device);
-    }();
-    auto ret = daxa_ImplCommandRecorder{};
-    ret.device = device;
-    ret.info = *info;
-    ret.vk_cmd_pool = vk_cmd_pool;
-    auto result = ret.generate_new_current_command_data();
+        ret->pool = device->command_pool_pools[info->queue_family].get(device);
+        result = DAXA_RESULT_SUCCESS;
+    }
+    if (result == DAXA_RESULT_SUCCESS)
+    {
+        result = ret->generate_new_current_command_data();
+    }
     if (result != DAXA_RESULT_SUCCESS)
     {
-        std::unique_lock lock{device->command_pool_pools[info->queue_family].mtx};
-        device->command_pool_pools[info->queue_family].put_back(vk_cmd_pool);
+        if (ret->pool.vk_cmd_pool != VK_NULL_HANDLE)
+        {
+            [[maybe_unused]] auto const _ignore = vkResetCommandPool(device->vk_device, ret->pool.vk_cmd_pool, {});
+            std::unique_lock lock{device->command_pool_pools[info->queue_family].mtx};
+            device->command_pool_pools[info->queue_family].put_back(std::move(ret->pool));
+        }
+        delete ret;
         return result;
     }
-    if ((ret.device->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret.info.name.size != 0)
+    if ((ret->device->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret->info.name.size != 0)
     {
-        auto cmd_pool_name = ret.info.name;
+        auto cmd_pool_name = ret->info.name;
         VkDebugUtilsObjectNameInfoEXT const cmd_pool_name_info{
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
             .objectType = VK_OBJECT_TYPE_COMMAND_POOL,
-            .objectHandle = std::bit_cast<uint64_t>(ret.vk_cmd_pool),
+            .objectHandle = std::bit_cast<uint64_t>(ret->pool.vk_cmd_pool),
             .pObjectName = cmd_pool_name.data,
         };
-        ret.device->vkSetDebugUtilsObjectNameEXT(ret.device->vk_device, &cmd_pool_name_info);
+        ret->device->vkSetDebugUtilsObjectNameEXT(ret->device->vk_device, &cmd_pool_name_info);
     }
-    // TODO(lifetime): Maybe we should have a try lock variant?
-    ret.device->gpu_sro_table.lifetime_lock.lock_shared();
-    ret.strong_count = 1;
+    // Resources destroyed from now on are kept alive until the recorder is destroyed.
+    ret->epoch = device->global_submit_timeline.load(std::memory_order_seq_cst);
+    ret->epoch_slot = device->recorder_epochs.publish(ret->epoch);
+    ret->strong_count = 1;
     device->inc_weak_refcnt();
-    *out_cmd_list = new daxa_ImplCommandRecorder{};
-    **out_cmd_list = std::move(ret);
+    *out_cmd_list = ret;
     return DAXA_RESULT_SUCCESS;
 }
 
+auto daxa_dvc_create_command_recorder(daxa_Device device, daxa_CommandRecorderInfo const * info, daxa_CommandRecorder * out_cmd_list) -> daxa_Result
+{
+    PROFILE_FUNC();
+    return create_command_recorder_helper(device, info, nullptr, out_cmd_list);
+}
+
 auto daxa_executable_commands_inc_refcnt(daxa_ExecutableCommandList self) -> u64
 {
     PROFILE_FUNC();
@@ -1368,37 +1845,196 @@ void executable_cmd_list_execute_deferred_destructions(daxa_Device device, Execu
     cmd_list.deferred_destructions.clear();
 }
 
+auto UsedIdSet::insert(u64 id, u32 kind) -> bool
+{
+    if ((this->count + 1) * 2 > this->entries.size())
+    {
+        // Rehash into twice the capacity, keeping only entries of the current generation.
+        std::vector<Entry> old_entries = std::move(this->entries);
+        this->entries = std::vector<Entry>(std::max(old_entries.size() * 2, INITIAL_CAPACITY));
+        this->count = 0;
+        u32 const old_generation = this->generation;
+        this->generation = 1;
+        for (auto const & entry : old_entries)
+        {
+            if (entry.generation == old_generation)
+            {
+                this->insert(entry.id, entry.kind);
+            }
+        }
+    }
+    usize const mask = this->entries.size() - 1;
+    // Fibonacci hashing, ids differ mostly in their lower index bits.
+    usize index = static_cast<usize>(((id ^ (static_cast<u64>(kind) << 60ull)) * 0x9E3779B97F4A7C15ull) >> 32ull) & mask;
+    while (true)
+    {
+        auto & entry = this->entries[index];
+        if (entry.generation != this->generation)
+        {
+            entry = Entry{.id = id, .kind = kind, .generation = this->generation};
+            ++this->count;
+            return true;
+        }
+        if (entry.id == id && entry.kind == kind)
+        {
+            return false;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void UsedIdSet::clear()
+{
+    this->count = 0;
+    ++this->generation;
+    // On wrap around, stale entries could alias the new generation.
+    if (this->generation == 0)
+    {
+        for (auto & entry : this->entries)
+        {
+            entry.generation = 0;
+        }
+        this->generation = 1;
+    }
+}
+
+void ExecutableCommandListData::clear()
+{
+    this->vk_cmd_buffer = {};
+    this->deferred_destructions.clear();
+    this->used_buffers.clear();
+    this->used_images.clear();
+    this->used_image_views.clear();
+    this->used_samplers.clear();
+    this->used_tlass.clear();
+    this->used_blass.clear();
+    for (daxa_ExecutableCommandList secondary : this->executed_secondaries)
+    {
+        [[maybe_unused]] u64 const _ignore = daxa_executable_commands_dec_refcnt(secondary);
+    }
+    this->executed_secondaries.clear();
+}
+
+void daxa_ImplCommandRecorder::recycle_command_data(ExecutableCommandListData && data)
+{
+    data.clear();
+    std::unique_lock const lock{this->recycled_command_data_mtx};
+    this->pool.recycled_command_data.push_back(std::move(data));
+}
+
 auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Result
 {
     PROFILE_FUNC();
-    VkCommandBufferAllocateInfo const vk_command_buffer_allocate_info{
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .pNext = nullptr,
-        .commandPool = this->vk_cmd_pool,
-        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandBufferCount = 1,
-    };
-    auto vk_result = vkAllocateCommandBuffers(this->device->vk_device, &vk_command_buffer_allocate_info, &this->current_command_data.vk_cmd_buffer);
-    if (vk_result != VK_SUCCESS)
+    this->current_used_ids.clear();
     {
-        return std::bit_cast<daxa_Result>(vk_result);
+        std::unique_lock const lock{this->recycled_command_data_mtx};
+        if (!this->pool.recycled_command_data.empty())
+        {
+            this->current_command_data = std::move(this->pool.recycled_command_data.back());
+            this->pool.recycled_command_data.pop_back();
+        }
+        else
+        {
+            this->current_command_data = {};
+            this->current_command_data.used_buffers.reserve(12);
+            this->current_command_data.used_images.reserve(12);
+            this->current_command_data.used_image_views.reserve(12);
+            this->current_command_data.used_samplers.reserve(12);
+        }
+    }
+    this->state_cache = {};
+    // The pool was reset before the recorder got it, so previously allocated command buffers are reused.
+    auto & pool_command_buffers = this->is_secondary ? this->pool.secondary_command_buffers : this->pool.primary_command_buffers;
+    if (this->used_command_buffer_count < pool_command_buffers.size())
+    {
+        this->current_command_data.vk_cmd_buffer = pool_command_buffers[this->used_command_buffer_count];
     }
+    else
+    {
+        VkCommandBufferAllocateInfo const vk_command_buffer_allocate_info{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .pNext = nullptr,
+            .commandPool = this->pool.vk_cmd_pool,
+            .level = this->is_secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1,
+        };
+        auto vk_result = vkAllocateCommandBuffers(this->device->vk_device, &vk_command_buffer_allocate_info, &this->current_command_data.vk_cmd_buffer);
+        if (vk_result != VK_SUCCESS)
+        {
+            return std::bit_cast<daxa_Result>(vk_result);
+        }
+        pool_command_buffers.push_back(this->current_command_data.vk_cmd_buffer);
+    }
+    // Secondary command buffers continue the dynamic renderpass they are executed in.
+    VkCommandBufferInheritanceRenderingInfo const vk_inheritance_rendering_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .viewMask = {},
+        .colorAttachmentCount = this->inherit_info.color_attachment_formats.size,
+        .pColorAttachmentFormats = this->inherit_info.color_attachment_formats.data,
+        .depthAttachmentFormat = this->inherit_info.depth_attachment_format,
+        .stencilAttachmentFormat = this->inherit_info.stencil_attachment_format,
+        .rasterizationSamples = this->inherit_info.rasterization_samples,
+    };
+    VkCommandBufferInheritanceInfo const vk_inheritance_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = &vk_inheritance_rendering_info,
+        .renderPass = VK_NULL_HANDLE,
+        .subpass = {},
+        .framebuffer = VK_NULL_HANDLE,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags = {},
+        .pipelineStatistics = {},
+    };
+    // Reusable lists may be pending on the gpu multiple times at once.
+    VkCommandBufferUsageFlags const vk_usage_flags = this->info.reusable_command_lists != 0
+                                                         ? VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+                                                         : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     VkCommandBufferBeginInfo const vk_command_buffer_begin_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext = nullptr,
-        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-        .pInheritanceInfo = {},
+        .flags = this->is_secondary
+                     ? static_cast<VkCommandBufferUsageFlags>(vk_usage_flags | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT)
+                     : vk_usage_flags,
+        .pInheritanceInfo = this->is_secondary ? &vk_inheritance_info : nullptr,
     };
-    vk_result = vkBeginCommandBuffer(this->current_command_data.vk_cmd_buffer, &vk_command_buffer_begin_info);
+    auto vk_result = vkBeginCommandBuffer(this->current_command_data.vk_cmd_buffer, &vk_command_buffer_begin_info);
     if (vk_result != VK_SUCCESS)
     {
         return std::bit_cast<daxa_Result>(vk_result);
     }
-    this->allocated_command_buffers.push_back(this->current_command_data.vk_cmd_buffer);
-    this->current_command_data.used_buffers.reserve(12);
-    this->current_command_data.used_images.reserve(12);
-    this->current_command_data.used_image_views.reserve(12);
-    this->current_command_data.used_samplers.reserve(12);
+    ++this->used_command_buffer_count;
+    // Transfer queues can not bind descriptor buffers, they never bind pipelines either.
+    if (this->info.queue_family != DAXA_QUEUE_FAMILY_TRANSFER)
+    {
+        this->bound_table_generation = this->device->gpu_sro_table.generation.load(std::memory_order_acquire);
+        this->device->gpu_sro_table.bind_descriptor_buffer(this->current_command_data.vk_cmd_buffer);
+    }
+    // Dynamic state is not inherited, so secondaries start with the same state a primary has after begin_renderpass.
+    if (this->is_secondary)
+    {
+        VkRect2D const & render_area = this->inherit_info.render_area;
+        vkCmdSetScissor(this->current_command_data.vk_cmd_buffer, 0, 1, &render_area);
+        VkViewport const vk_viewport = {
+            .x = static_cast<f32>(render_area.offset.x),
+            .y = static_cast<f32>(render_area.offset.y),
+            .width = static_cast<f32>(render_area.extent.width),
+            .height = static_cast<f32>(render_area.extent.height),
+            .minDepth = 0.0f,
+            .maxDepth = 1.0f,
+        };
+        vkCmdSetViewport(this->current_command_data.vk_cmd_buffer, 0, 1, &vk_viewport);
+        this->state_cache.has_scissor = true;
+        this->state_cache.scissor = render_area;
+        this->state_cache.has_viewport = true;
+        this->state_cache.viewport = vk_viewport;
+        if (this->device->vkCmdSetRasterizationSamplesEXT != nullptr)
+        {
+            this->device->vkCmdSetRasterizationSamplesEXT(this->current_command_data.vk_cmd_buffer, this->inherit_info.rasterization_samples);
+        }
+        this->in_renderpass = true;
+    }
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -1407,15 +2043,21 @@ void daxa_ImplCommandRecorder::zero_ref_callback(ImplHandle const * handle)
     PROFILE_FUNC();
     auto * self = rc_cast<daxa_CommandRecorder>(handle);
     u64 const submit_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    std::unique_lock const lock{self->device->zombies_mtx};
     executable_cmd_list_execute_deferred_destructions(self->device, self->current_command_data);
-    self->device->command_list_zombies.emplace_front(
-        submit_timeline,
-        CommandRecorderZombie{
-            .queue_family = self->info.queue_family,
-            .vk_cmd_pool = self->vk_cmd_pool,
-            .allocated_command_buffers = std::move(self->allocated_command_buffers),
-        });
+    self->recycle_command_data(std::move(self->current_command_data));
+    // All executable command lists of the recorder are dead, so the pool can be handed on.
+    // It goes into the cache of this thread, only when that is full the garbage collector recycles it.
+    ThreadCommandPoolCache * thread_cache = self->device->thread_command_pool_cache();
+    if (thread_cache == nullptr || !thread_cache->try_push(self->info.queue_family, submit_timeline, std::move(self->pool)))
+    {
+        self->device->command_list_zombies.push(
+            submit_timeline,
+            CommandRecorderZombie{
+                .queue_family = self->info.queue_family,
+                .pool = std::move(self->pool),
+            });
+        self->device->notify_garbage_collector();
+    }
     self->device->dec_weak_refcnt(
         &daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -1426,7 +2068,9 @@ void daxa_ImplExecutableCommandList::zero_ref_callback(ImplHandle const * handle
 {
     PROFILE_FUNC();
     auto * self = rc_cast<daxa_ExecutableCommandList>(handle);
+    // Reusable lists defer their destructions until here, as they may be submitted again at any time before.
     executable_cmd_list_execute_deferred_destructions(self->cmd_recorder->device, self->data);
+    self->cmd_recorder->recycle_command_data(std::move(self->data));
     self->cmd_recorder->dec_refcnt(
         daxa_ImplCommandRecorder::zero_ref_callback,
         self->cmd_recorder->device->instance);
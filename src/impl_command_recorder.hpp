@@ -18,18 +18,82 @@ static inline constexpr u8 DEFERRED_DESTRUCTION_TIMELINE_QUERY_POOL_INDEX = 4;
 // TODO: maybe reintroduce this in some fashion?
 // static inline constexpr usize DEFERRED_DESTRUCTION_COUNT_MAX = 32;
 
-static inline constexpr usize COMMAND_LIST_BARRIER_MAX_BATCH_SIZE = 16;
 static inline constexpr usize COMMAND_LIST_COLOR_ATTACHMENT_MAX = 16;
+// Minimum maxMultiDrawCount guaranteed by VK_EXT_multi_draw.
+static inline constexpr usize COMMAND_LIST_MULTI_DRAW_MAX_BATCH_SIZE = 1024;
+
+static inline constexpr u32 USED_ID_KIND_BUFFER = 0;
+static inline constexpr u32 USED_ID_KIND_IMAGE = 1;
+static inline constexpr u32 USED_ID_KIND_IMAGE_VIEW = 2;
+static inline constexpr u32 USED_ID_KIND_SAMPLER = 3;
+static inline constexpr u32 USED_ID_KIND_TLAS = 4;
+static inline constexpr u32 USED_ID_KIND_BLAS = 5;
+
+// Open addressing set of the ids used by the current command list.
+// Entries are stamped with a generation, so clearing the set is O(1).
+// Used to deduplicate id tracking, so submit validation cost scales with unique resources instead of commands.
+struct UsedIdSet
+{
+    static inline constexpr usize INITIAL_CAPACITY = 64;
+    struct Entry
+    {
+        u64 id = {};
+        u32 kind = {};
+        u32 generation = {};
+    };
+    std::vector<Entry> entries = {};
+    u32 generation = 1;
+    usize count = {};
+
+    // Returns true if the id was not yet part of the set.
+    auto insert(u64 id, u32 kind) -> bool;
+    void clear();
+};
+
+struct ExecutableCommandListData
+{
+    VkCommandBuffer vk_cmd_buffer = {};
+    std::vector<std::pair<GPUResourceId, u8>> deferred_destructions = {};
+    // The vectors are recycled by the recorder once the executable command list dies.
+    // They keep their capacity, so recording does not allocate in steady state.
+    // If there is demand, we could make an instance or cmd list flag to disable the submit checks.
+    // TODO:    Also collect ref counted handles.
+    std::vector<BufferId> used_buffers = {};
+    std::vector<ImageId> used_images = {};
+    std::vector<ImageViewId> used_image_views = {};
+    std::vector<SamplerId> used_samplers = {};
+    std::vector<TlasId> used_tlass = {};
+    std::vector<BlasId> used_blass = {};
+    // Secondary command lists executed by this command list.
+    // They hold a reference, so their command buffers outlive the execution of this command list.
+    std::vector<daxa_ExecutableCommandList> executed_secondaries = {};
+
+    // Releases the executed secondaries and clears all lists, keeping their memory.
+    void clear();
+};
+
+// A command pool and everything allocated for it, recycled as a whole between recorders.
+// Resetting the pool resets all its command buffers, so they are reused instead of freed and reallocated.
+struct CommandPoolEntry
+{
+    VkCommandPool vk_cmd_pool = {};
+    std::vector<VkCommandBuffer> primary_command_buffers = {};
+    std::vector<VkCommandBuffer> secondary_command_buffers = {};
+    // Cleared data of dead executable command lists, see daxa_ImplCommandRecorder::recycle_command_data.
+    std::vector<ExecutableCommandListData> recycled_command_data = {};
+
+    void destroy(daxa_Device device);
+};
 
 struct CommandPoolPool
 {
-    auto get(daxa_Device device) -> VkCommandPool;
+    auto get(daxa_Device device) -> CommandPoolEntry;
 
-    void put_back(VkCommandPool pool_and_buffer);
+    void put_back(CommandPoolEntry && pool);
 
     void cleanup(daxa_Device device);
 
-    std::vector<VkCommandPool> pools_and_buffers = {};
+    std::vector<CommandPoolEntry> pools = {};
     u32 queue_family_index = {~0u};
     std::mutex mtx = {};
 };
@@ -37,46 +101,123 @@ struct CommandPoolPool
 struct CommandRecorderZombie
 {
     daxa_QueueFamily queue_family = {};
-    VkCommandPool vk_cmd_pool = {};
-    std::vector<VkCommandBuffer> allocated_command_buffers = {};
+    CommandPoolEntry pool = {};
 };
 
-struct ExecutableCommandListData
+// Per thread cache of the command pools of recorders, that died on the thread.
+// Recorder creation on the same thread reuses them without touching the shared CommandPoolPool.
+// Pools are only reset and reused once all submits up to their timeline value finished.
+// Only accessed by its thread, except for device cleanup.
+struct ThreadCommandPoolCache
 {
-    VkCommandBuffer vk_cmd_buffer = {};
-    std::vector<std::pair<GPUResourceId, u8>> deferred_destructions = {};
-    // TODO:    These vectors seem to be fast enough. overhead is around 1-4% in cmd recording.
-    //          It might be cool to have some slab allocator for these.
-    // If there is demand, we could make an instance or cmd list flag to disable the submit checks.
-    // TODO:    Also collect ref counted handles.
-    std::vector<BufferId> used_buffers = {};
-    std::vector<ImageId> used_images = {};
-    std::vector<ImageViewId> used_image_views = {};
-    std::vector<SamplerId> used_samplers = {};
-    std::vector<TlasId> used_tlass = {};
-    std::vector<BlasId> used_blass = {};
+    static inline constexpr usize MAX_RETIRED_POOLS_PER_FAMILY = 8;
+    struct RetiredPool
+    {
+        u64 timeline_value = {};
+        CommandPoolEntry pool = {};
+    };
+    // Ring buffer, oldest pool first.
+    struct FamilyPools
+    {
+        std::array<RetiredPool, MAX_RETIRED_POOLS_PER_FAMILY> pools = {};
+        usize head = {};
+        usize count = {};
+    };
+    std::array<FamilyPools, 3> families = {};
+
+    // Returns false when the cache for the family is full.
+    auto try_push(daxa_QueueFamily queue_family, u64 timeline_value, CommandPoolEntry && pool) -> bool;
+    // Pops and resets the oldest pool, if the gpu is known to be done with it.
+    auto try_pop(daxa_Device device, daxa_QueueFamily queue_family, CommandPoolEntry & out_pool) -> daxa_Result;
+    void cleanup(daxa_Device device);
+};
+
+// Alive recorders publish the submit timeline value of their creation here, similar to hazard pointers.
+// Zombies with a timeline value at or after the oldest published value may still be referenced by a recorder and are kept alive.
+// Publishing and retiring never lock in the common case and the garbage collector only reads, so neither side blocks the other.
+struct RecorderEpochs
+{
+    static inline constexpr usize SLOT_COUNT = 256;
+    static inline constexpr u32 OVERFLOW_SLOT = ~0u;
+    // Holds the epoch + 1, zero marks a free slot.
+    std::array<std::atomic_uint64_t, SLOT_COUNT> slots = {};
+    // Only used when more recorders are alive than there are slots.
+    std::mutex overflow_mtx = {};
+    std::vector<u64> overflow_epochs = {};
+    std::atomic_uint32_t overflow_count = {};
+
+    // Returns the slot the epoch was published in.
+    auto publish(u64 epoch) -> u32;
+    void retire(u32 slot, u64 epoch);
+    // Returns the max u64 value when no recorder is alive.
+    auto oldest() -> u64;
+};
+
+// Shadow of the state set on the current command buffer, used to filter redundant state commands.
+struct RecorderStateCache
+{
+    bool has_viewport = {};
+    VkViewport viewport = {};
+    bool has_scissor = {};
+    VkRect2D scissor = {};
+    bool has_depth_bias = {};
+    daxa_DepthBiasInfo depth_bias = {};
+    VkBuffer index_buffer = {};
+    VkDeviceSize index_buffer_offset = {};
+    VkIndexType index_type = {};
 };
 
 struct daxa_ImplCommandRecorder final : ImplHandle
 {
     daxa_Device device = {};
     bool in_renderpass = {};
+    // Set between begin and end of a renderpass, that executes secondary command lists.
+    bool in_secondary_renderpass = {};
     daxa_CommandRecorderInfo info = {};
-    VkCommandPool vk_cmd_pool = {};
-    std::vector<VkCommandBuffer> allocated_command_buffers = {};
-    std::array<VkMemoryBarrier2, COMMAND_LIST_BARRIER_MAX_BATCH_SIZE> memory_barrier_batch = {};
-    std::array<VkImageMemoryBarrier2, COMMAND_LIST_BARRIER_MAX_BATCH_SIZE> image_barrier_batch = {};
-    usize image_barrier_batch_count = {};
-    usize memory_barrier_batch_count = {};
-    usize split_barrier_batch_count = {};
+    // Secondary recorders record into the renderpass described by the inherit info.
+    bool is_secondary = {};
+    daxa_RenderPassInheritInfo inherit_info = {};
+    CommandPoolEntry pool = {};
+    // Command buffers of the pool are handed out in order, the pool was reset before the recorder got it.
+    usize used_command_buffer_count = {};
+    // Barriers are batched until the next non barrier command, see daxa_cmd_flush_barriers.
+    // All memory barriers of a batch are merged into one, barriers on the same buffer or image range are merged as well.
+    VkMemoryBarrier2 memory_barrier_batch = {};
+    bool has_memory_barrier_batch = {};
+    std::vector<VkImageMemoryBarrier2> image_barrier_batch = {};
+    std::vector<VkBufferMemoryBarrier2> buffer_barrier_batch = {};
+    // Scratch memory for event signals and waits, keeps its capacity.
+    std::vector<VkMemoryBarrier2> split_barrier_memory_barriers = {};
+    std::vector<VkImageMemoryBarrier2> split_barrier_image_barriers = {};
+    std::vector<VkDependencyInfo> split_barrier_dependency_infos = {};
+    std::vector<VkEvent> split_barrier_events = {};
+    // Scratch memory for multi draws, keeps its capacity.
+    std::vector<VkMultiDrawIndexedInfoEXT> multi_draw_indexed_infos = {};
     struct NoPipeline
     {
     };
     Variant<NoPipeline, daxa_ComputePipeline, daxa_RasterPipeline, daxa_RayTracingPipeline> current_pipeline = NoPipeline{};
+    // Generation of the resource table that was bound last, see rebind_descriptor_buffer_if_table_grown.
+    u32 bound_table_generation = {};
+    // Cached when a pipeline is set, so push constants do not have to visit the variant.
+    VkPipelineLayout current_pipeline_layout = {};
+    u32 current_push_constant_size = {};
+    // Only maintained when the recorder filters redundant state.
+    RecorderStateCache state_cache = {};
+    daxa_CommandRecorderStats stats = {};
 
     ExecutableCommandListData current_command_data = {};
+    UsedIdSet current_used_ids = {};
+    // Cached from the device info, false when id tracking is disabled.
+    bool track_ids = {};
+    // Guards pool.recycled_command_data, executable command lists may die on any thread.
+    std::mutex recycled_command_data_mtx = {};
+    // Published in the devices recorder epochs from creation until the recorder is destroyed.
+    u64 epoch = {};
+    u32 epoch_slot = {};
 
     auto generate_new_current_command_data() -> daxa_Result;
+    void recycle_command_data(ExecutableCommandListData && data);
 
     static void zero_ref_callback(ImplHandle const * handle);
 };
@@ -85,8 +226,13 @@ struct daxa_ImplExecutableCommandList final : ImplHandle
 {
     daxa_CommandRecorder cmd_recorder = {};
     ExecutableCommandListData data = {};
+    // Lists that are not reusable are recorded for one time submit and can only be submitted once.
+    std::atomic_bool submitted = {};
 
     static void zero_ref_callback(ImplHandle const * handle);
 };
 
-void executable_cmd_list_execute_deferred_destructions(daxa_Device device, ExecutableCommandListData & cmd_list);
\ No newline at end of file
+void executable_cmd_list_execute_deferred_destructions(daxa_Device device, ExecutableCommandListData & cmd_list);
+
+// Creates a secondary recorder when opt_inherit_info is set.
+auto create_command_recorder_helper(daxa_Device device, daxa_CommandRecorderInfo const * info, daxa_RenderPassInheritInfo const * opt_inherit_info, daxa_CommandRecorder * out_cmd_list) -> daxa_Result;
\ No newline at end of file
@@ -588,13 +588,13 @@ auto daxa_memory_block_dec_refcnt(daxa_MemoryBlock self) -> u64
 void daxa_ImplMemoryBlock::zero_ref_callback(ImplHandle const * handle)
 {
     auto const * self = r_cast<daxa_ImplMemoryBlock const*>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const submit_timeline_value = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->memory_block_zombies.emplace_front(
+    self->device->memory_block_zombies.push(
         submit_timeline_value,
         MemoryBlockZombie{
             .allocation = self->allocation,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
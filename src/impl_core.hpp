@@ -52,6 +52,9 @@
 #include <vma/vk_mem_alloc.h>
 #include <daxa/c/daxa.h>
 
+#include <array>
+#include <atomic>
+
 #if DAXA_BUILT_WITH_TLIB
 #include <tlib/app/tprofiler.h>
 #define PROFILE_SCOPE(name) TProfileZoneCpu tlibProfileZone(name)
@@ -77,6 +80,41 @@ auto r_cast(FROM_T * ptr)
     return reinterpret_cast<TO_T>(ptr);
 }
 
+// Relaxed counter, split into cache line sized shards.
+// Each thread increments its own shard, so hot paths never contend on the counter.
+// Reads sum up all shards, they are slower and only meant for statistics.
+struct ShardedCounter
+{
+    static constexpr inline usize SHARD_COUNT = 16;
+    struct alignas(64) Shard
+    {
+        std::atomic_uint64_t value = {};
+    };
+    std::array<Shard, SHARD_COUNT> shards = {};
+
+    static auto thread_shard_index() -> usize
+    {
+        static std::atomic_uint32_t next_thread_index = {};
+        thread_local usize const index = next_thread_index.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+        return index;
+    }
+
+    void add(u64 value = 1)
+    {
+        this->shards[thread_shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    auto load() const -> u64
+    {
+        u64 sum = {};
+        for (auto const & shard : this->shards)
+        {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+};
+
 // TODO: WTF IS THIS?!
 static inline constexpr char const * MAX_PUSH_CONSTANT_SIZE_ERROR = {"push constant size is limited to 128 bytes/ 32 device words"};
 static inline constexpr u32 GPU_TABLE_SET_BINDING = 0;
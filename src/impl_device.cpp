@@ -1,5 +1,7 @@
 #include "impl_device.hpp"
 
+#include <chrono>
+#include <cstring>
 #include <unordered_map>
 #include <utility>
 #include "daxa/core.hpp"
@@ -69,6 +71,220 @@ namespace
         }
         return result;
     }
+
+    // Reused by all submits of a thread, so that a submit does not allocate once the vectors reached their peak size.
+    struct SubmitScratch
+    {
+        std::vector<VkCommandBufferSubmitInfo> command_buffers = {};
+        std::vector<VkSemaphoreSubmitInfo> waits = {};
+        std::vector<VkSemaphoreSubmitInfo> signals = {};
+        std::vector<VkSubmitInfo2> submits = {};
+
+        void clear()
+        {
+            command_buffers.clear();
+            waits.clear();
+            signals.clear();
+            submits.clear();
+        }
+
+        // The VkSubmitInfo2s point into the other vectors, so these must never reallocate while a queue submit is assembled.
+        void reserve(daxa_CommandSubmitInfo const & info)
+        {
+            command_buffers.reserve(command_buffers.size() + info.command_list_count);
+            waits.reserve(waits.size() + info.wait_timeline_semaphore_count + info.wait_binary_semaphore_count);
+            signals.reserve(signals.size() + 1 + info.signal_timeline_semaphore_count + info.signal_binary_semaphore_count);
+            submits.reserve(submits.size() + 1);
+        }
+    };
+    thread_local SubmitScratch tl_submit_scratch = {};
+
+    // Allows the first list_count one time submit lists of the info to be submitted again, after their submit failed.
+    void release_submit_claims(daxa_CommandSubmitInfo const & info, usize list_count)
+    {
+        for (daxa_ExecutableCommandList commands : std::span{info.command_lists, list_count})
+        {
+            if (commands->cmd_recorder->info.reusable_command_lists == 0)
+            {
+                commands->submitted.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto validate_submit_info(daxa_Device self, daxa_CommandSubmitInfo const & info) -> daxa_Result
+    {
+        if (!self->valid_queue(info.queue))
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
+        }
+        if (static_cast<u32>(info.queue.index) >= self->queue_families[info.queue.family].queue_count)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
+        }
+
+        bool const binary_stages_valid = info.wait_binary_semaphore_stage_count == 0 || info.wait_binary_semaphore_stage_count == info.wait_binary_semaphore_count;
+        bool const timeline_stages_valid = info.wait_timeline_semaphore_stage_count == 0 || info.wait_timeline_semaphore_stage_count == info.wait_timeline_semaphore_count;
+        if (!binary_stages_valid || !timeline_stages_valid)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_WAIT_STAGE_COUNT_MISMATCH, DAXA_RESULT_ERROR_WAIT_STAGE_COUNT_MISMATCH);
+        }
+
+        for (daxa_ExecutableCommandList commands : std::span{info.command_lists, info.command_list_count})
+        {
+            if (commands->cmd_recorder->info.queue_family != info.queue.family)
+            {
+                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
+            }
+            // Secondary command lists are executed through their primary.
+            if (commands->cmd_recorder->is_secondary)
+            {
+                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_SECONDARY_CMD_LIST_SUBMITTED, DAXA_RESULT_ERROR_SECONDARY_CMD_LIST_SUBMITTED);
+            }
+#if DAXA_TRACK_IDS
+            if (self->info.disable_id_tracking == 0)
+            {
+                for (BufferId id : commands->data.used_buffers)
+                {
+                    if (!daxa_dvc_is_buffer_valid(self, id))
+                    {
+                        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID);
+                    }
+                }
+                for (ImageId id : commands->data.used_images)
+                {
+                    if (!daxa_dvc_is_image_valid(self, id))
+                    {
+                        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID);
+                    }
+                }
+                for (ImageViewId id : commands->data.used_image_views)
+                {
+                    if (!daxa_dvc_is_image_view_valid(self, id))
+                    {
+                        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID);
+                    }
+                }
+                for (SamplerId id : commands->data.used_samplers)
+                {
+                    if (!daxa_dvc_is_sampler_valid(self, id))
+                    {
+                        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID);
+                    }
+                }
+            }
+#endif
+        }
+        // Claimed last, so that a failed validation never leaves claims behind.
+        // The exchange makes concurrent submits of the same list fail instead of both passing validation.
+        for (usize i = 0; i < info.command_list_count; ++i)
+        {
+            daxa_ExecutableCommandList commands = info.command_lists[i];
+            if (commands->cmd_recorder->info.reusable_command_lists == 0 && commands->submitted.exchange(true, std::memory_order_relaxed))
+            {
+                release_submit_claims(info, i);
+                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_ALREADY_SUBMITTED, DAXA_RESULT_ERROR_CMD_LIST_ALREADY_SUBMITTED);
+            }
+        }
+        return DAXA_RESULT_SUCCESS;
+    }
+
+    // Appends the vulkan submit info of one logical submit to the scratch. The scratch must have been reserved for it.
+    void append_submit_info(SubmitScratch & scratch, daxa_CommandSubmitInfo const & info, VkSemaphore queue_timeline, u64 timeline_value)
+    {
+        usize const first_command_buffer = scratch.command_buffers.size();
+        usize const first_wait = scratch.waits.size();
+        usize const first_signal = scratch.signals.size();
+
+        for (auto const & commands : std::span{info.command_lists, info.command_list_count})
+        {
+            scratch.command_buffers.push_back(VkCommandBufferSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                .pNext = nullptr,
+                .commandBuffer = commands->data.vk_cmd_buffer,
+                .deviceMask = 0,
+            });
+        }
+
+        // Add main queue timeline signaling as first semaphore signaling:
+        scratch.signals.push_back(VkSemaphoreSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .pNext = nullptr,
+            .semaphore = queue_timeline,
+            .value = timeline_value,
+            .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            .deviceIndex = 0,
+        });
+
+        for (auto const & pair : std::span{info.signal_timeline_semaphores, info.signal_timeline_semaphore_count})
+        {
+            scratch.signals.push_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = pair.semaphore->vk_semaphore,
+                .value = pair.value,
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                .deviceIndex = 0,
+            });
+        }
+
+        for (auto const & binary_semaphore : std::span{info.signal_binary_semaphores, info.signal_binary_semaphore_count})
+        {
+            scratch.signals.push_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = binary_semaphore->vk_semaphore,
+                .value = 0, // Ignored for binary semaphores.
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                .deviceIndex = 0,
+            });
+        }
+
+        // used to synchronize with previous submits.
+        // Waits block all commands unless the submit or the single wait narrows them down to specific stages:
+        VkPipelineStageFlags2 const wait_stage_mask = info.wait_stages != 0 ? info.wait_stages : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        auto const stage_mask_of_wait = [&](VkPipelineStageFlags2 const * opt_wait_stages, u64 wait_index)
+        {
+            return opt_wait_stages != nullptr && opt_wait_stages[wait_index] != 0 ? opt_wait_stages[wait_index] : wait_stage_mask;
+        };
+        VkPipelineStageFlags2 const * const timeline_wait_stages = info.wait_timeline_semaphore_stage_count != 0 ? info.wait_timeline_semaphore_stages : nullptr;
+        VkPipelineStageFlags2 const * const binary_wait_stages = info.wait_binary_semaphore_stage_count != 0 ? info.wait_binary_semaphore_stages : nullptr;
+
+        for (u64 i = 0; i < info.wait_timeline_semaphore_count; ++i)
+        {
+            scratch.waits.push_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = info.wait_timeline_semaphores[i].semaphore->vk_semaphore,
+                .value = info.wait_timeline_semaphores[i].value,
+                .stageMask = stage_mask_of_wait(timeline_wait_stages, i),
+                .deviceIndex = 0,
+            });
+        }
+
+        for (u64 i = 0; i < info.wait_binary_semaphore_count; ++i)
+        {
+            scratch.waits.push_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .pNext = nullptr,
+                .semaphore = info.wait_binary_semaphores[i]->vk_semaphore,
+                .value = 0, // Ignored for binary semaphores.
+                .stageMask = stage_mask_of_wait(binary_wait_stages, i),
+                .deviceIndex = 0,
+            });
+        }
+
+        scratch.submits.push_back(VkSubmitInfo2{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .pNext = nullptr,
+            .flags = {},
+            .waitSemaphoreInfoCount = static_cast<u32>(scratch.waits.size() - first_wait),
+            .pWaitSemaphoreInfos = scratch.waits.data() + first_wait,
+            .commandBufferInfoCount = static_cast<u32>(scratch.command_buffers.size() - first_command_buffer),
+            .pCommandBufferInfos = scratch.command_buffers.data() + first_command_buffer,
+            .signalSemaphoreInfoCount = static_cast<u32>(scratch.signals.size() - first_signal),
+            .pSignalSemaphoreInfos = scratch.signals.data() + first_signal,
+        });
+    }
 } // namespace
 
 auto daxa_ImplDevice::ImplQueue::initialize(VkDevice vk_device) -> daxa_Result
@@ -116,9 +332,11 @@ auto daxa_ImplDevice::ImplQueue::get_oldest_pending_submit(VkDevice vk_device, s
         auto result = static_cast<daxa_Result>(vkGetSemaphoreCounterValue(vk_device, this->gpu_queue_local_timeline, &latest_gpu));
         _DAXA_RETURN_IF_ERROR(result, result);
 
-        u64 latest_cpu = this->latest_pending_submit_timeline_value.load(std::memory_order::acquire);
+        // Checked before the pending value, a submit lowers it only after storing that value.
+        bool const submit_in_flight = this->submits_in_flight.load(std::memory_order::seq_cst) != 0;
+        u64 latest_cpu = this->latest_pending_submit_timeline_value.load(std::memory_order::seq_cst);
 
-        bool const cpu_ahead_of_gpu = latest_cpu > latest_gpu;
+        bool const cpu_ahead_of_gpu = submit_in_flight || latest_cpu > latest_gpu;
         if (cpu_ahead_of_gpu)
         {
             out = latest_gpu;
@@ -127,7 +345,7 @@ auto daxa_ImplDevice::ImplQueue::get_oldest_pending_submit(VkDevice vk_device, s
     return DAXA_RESULT_SUCCESS;
 }
 
-auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_BufferId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_BufferId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset, DescriptorWriteBatch * opt_write_batch = nullptr, u32 * opt_reserved_index = nullptr) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     // --- Begin Parameter Validation ---
@@ -143,14 +361,20 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
 
     // --- End Parameter Validation ---
 
-    auto slot_opt = self->gpu_sro_table.buffer_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index != nullptr
+                        ? self->gpu_sro_table.buffer_slots.create_reserved_slot(*opt_reserved_index)
+                        : self->gpu_sro_table.buffer_slots.try_create_slot_or_grow(
+                              [&](u32 observed_max_buffers)
+                              {
+                                  return self->try_grow_buffer_slots(observed_max_buffers);
+                              });
     if (!slot_opt.has_value())
     {
         result = DAXA_RESULT_EXCEEDED_MAX_BUFFERS;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
 
     defer
     {
@@ -164,13 +388,14 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
+    ret.size = info->size;
 
     VkBufferCreateInfo const vk_buffer_create_info{
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
-        .size = static_cast<VkDeviceSize>(ret.info.size),
+        .size = static_cast<VkDeviceSize>(info->size),
         .usage = create_buffer_use_flags(self),
         .sharingMode = VK_SHARING_MODE_CONCURRENT,                  // Buffers are always shared.
         .queueFamilyIndexCount = self->valid_vk_queue_family_count, // Buffers are always shared across all queues.
@@ -239,7 +464,7 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
 
     ret.host_address = host_accessible ? vma_allocation_info.pMappedData : nullptr;
 
-    self->buffer_device_address_buffer_host_ptr[id.index] = ret.device_address;
+    self->write_buffer_device_address(id.index, ret.device_address);
 
     if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE &&
         info->name.size != 0)
@@ -255,22 +480,20 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &buffer_name_info);
     }
 
+    if (opt_write_batch != nullptr)
+    {
+        opt_write_batch->add_buffer(ret.vk_buffer, ret.device_address, 0, static_cast<VkDeviceSize>(info->size), id.index);
+    }
+    else
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_buffer(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set, ret.vk_buffer,
-            0,
-            static_cast<VkDeviceSize>(ret.info.size),
-            id.index);
+        self->gpu_sro_table.queue_buffer_write(ret.vk_buffer, ret.device_address, 0, static_cast<VkDeviceSize>(info->size), id.index);
     }
 
     *out_id = std::bit_cast<daxa_BufferId>(id);
     return result;
 }
 
-auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_ImageId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_ImageId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset, DescriptorWriteBatch * opt_write_batch = nullptr, u32 * opt_reserved_index = nullptr) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     /// --- Begin Validation ---
@@ -282,14 +505,16 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
 
     /// --- End Validation ---
 
-    auto slot_opt = self->gpu_sro_table.image_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index != nullptr
+                        ? self->gpu_sro_table.image_slots.create_reserved_slot(*opt_reserved_index)
+                        : self->gpu_sro_table.image_slots.try_create_slot_or_grow();
     if (!slot_opt.has_value())
     {
         result = DAXA_RESULT_EXCEEDED_MAX_IMAGES;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -315,10 +540,11 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
         vk_image_view_type = static_cast<VkImageViewType>(info->dimensions - 1);
     }
 
-    ret.info = *info;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret_cold.info = *info;
+    ret.view_slot.image = std::bit_cast<daxa_ImageId>(id);
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(vk_image_view_type),
-        .format = std::bit_cast<Format>(ret.info.format),
+        .format = std::bit_cast<Format>(info->format),
         .image = {id},
         .slice = ImageMipArraySlice{
             .base_mip_level = 0,
@@ -416,15 +642,13 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &swapchain_image_view_name_info);
     }
 
+    if (opt_write_batch != nullptr)
+    {
+        opt_write_batch->add_image(ret.view_slot.vk_image_view, std::bit_cast<ImageUsageFlags>(info->usage), id.index);
+    }
+    else
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
-            ret.view_slot.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(ret.info.usage),
-            id.index);
+        self->gpu_sro_table.queue_image_write(ret.view_slot.vk_image_view, std::bit_cast<ImageUsageFlags>(info->usage), id.index);
     }
     *out_id = std::bit_cast<daxa_ImageId>(id);
     return result;
@@ -457,7 +681,7 @@ auto create_acceleration_structure_helper(
     }
     _DAXA_RETURN_IF_ERROR(result, result);
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -470,7 +694,7 @@ auto create_acceleration_structure_helper(
         }
     };
 
-    ret.info = info;
+    ret_cold.info = info;
 
     if (buffer)
     {
@@ -480,17 +704,17 @@ auto create_acceleration_structure_helper(
     }
     else
     {
-        daxa::SmallString buffer_name{std::string_view{ret.info.name.data, ret.info.name.size}};
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        daxa::SmallString buffer_name{std::string_view{info.name.data, info.name.size}};
+        if (info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back(' ');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('b');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('u');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('f');
         auto cinfo = daxa_BufferInfo{
-            .size = ret.info.size,
+            .size = info.size,
             .name = std::bit_cast<daxa_SmallString>(buffer_name),
         };
         result = daxa_dvc_create_buffer(self, &cinfo, r_cast<daxa_BufferId *>(&ret.buffer_id));
@@ -506,7 +730,7 @@ auto create_acceleration_structure_helper(
         .createFlags = {}, // VK_ACCELERATION_STRUCTURE_CREATE_DEVICE_ADDRESS_CAPTURE_REPLAY_BIT_KHR,
         .buffer = self->slot(ret.buffer_id).vk_buffer,
         .offset = ret.offset,
-        .size = ret.info.size,
+        .size = info.size,
         .type = vk_as_type,
         .deviceAddress = {},
     };
@@ -522,9 +746,9 @@ auto create_acceleration_structure_helper(
         self->vk_device,
         &vk_acceleration_structure_device_address_info_khr);
 
-    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret.info.name.size != 0)
+    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && info.name.size != 0)
     {
-        auto c_str_arr = r_cast<SmallString const *>(&ret.info.name)->c_str();
+        auto c_str_arr = r_cast<SmallString const *>(&info.name)->c_str();
         VkDebugUtilsObjectNameInfoEXT const swapchain_image_name_info{
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
@@ -537,13 +761,7 @@ auto create_acceleration_structure_helper(
 
     if (vk_as_type == VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR)
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_acceleration_structure(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
-            ret.vk_acceleration_structure,
-            id.index);
+        self->gpu_sro_table.queue_acceleration_structure_write(ret.vk_acceleration_structure, ret.device_address, id.index);
     }
 
     *out_id = std::bit_cast<typename std::remove_pointer<decltype(out_id)>::type>(id);
@@ -581,10 +799,10 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
     // TODO: Refactor all objects to live in arrays so we can always iterate all objects.
     std::unordered_map<daxa_MemoryBlock, u32> mem_blocks = {};
 
-    for (u32 bi = 0; bi < self->gpu_sro_table.buffer_slots.next_index; ++bi)
+    for (u32 bi = 0; bi < self->gpu_sro_table.buffer_slots.next_index.load(std::memory_order_relaxed); ++bi)
     {
         u64 version = self->gpu_sro_table.buffer_slots.version_of_slot(bi);
-        if ((version & GpuResourcePool<u32>::VERSION_ZOMBIE_BIT) == 0) 
+        if ((version & GpuResourcePool<u32, u32>::VERSION_ZOMBIE_BIT) == 0) 
         {
             daxa::BufferId id = { bi, version };
             auto& slot = self->gpu_sro_table.buffer_slots.unsafe_get(id);
@@ -606,7 +824,7 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
             }
             else
             {
-                auto requirements = daxa_dvc_buffer_memory_requirements(self, &slot.info);
+                auto requirements = daxa_dvc_buffer_memory_requirements(self, &self->gpu_sro_table.buffer_slots.unsafe_get_cold(id).info);
                 memory_size = requirements.size;
             }
 
@@ -626,10 +844,10 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
         }
     }
 
-    for (u32 ii = 0; ii < self->gpu_sro_table.image_slots.next_index; ++ii)
+    for (u32 ii = 0; ii < self->gpu_sro_table.image_slots.next_index.load(std::memory_order_relaxed); ++ii)
     {
         u64 version = self->gpu_sro_table.image_slots.version_of_slot(ii);
-        if ((version & GpuResourcePool<u32>::VERSION_ZOMBIE_BIT) == 0) 
+        if ((version & GpuResourcePool<u32, u32>::VERSION_ZOMBIE_BIT) == 0) 
         {
             daxa::ImageId id = { ii, version };
             auto& slot = self->gpu_sro_table.image_slots.unsafe_get(id);
@@ -651,7 +869,7 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
             }
             else
             {
-                auto requirements = daxa_dvc_image_memory_requirements(self, &slot.info);
+                auto requirements = daxa_dvc_image_memory_requirements(self, &self->gpu_sro_table.image_slots.unsafe_get_cold(id).info);
                 memory_size = requirements.size;
             }
 
@@ -671,10 +889,10 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
         }
     }
     
-    for (u32 ti = 0; ti < self->gpu_sro_table.tlas_slots.next_index; ++ti)
+    for (u32 ti = 0; ti < self->gpu_sro_table.tlas_slots.next_index.load(std::memory_order_relaxed); ++ti)
     {
         u64 version = self->gpu_sro_table.tlas_slots.version_of_slot(ti);
-        if ((version & GpuResourcePool<u32>::VERSION_ZOMBIE_BIT) == 0) 
+        if ((version & GpuResourcePool<u32, u32>::VERSION_ZOMBIE_BIT) == 0) 
         {
             daxa::TlasId id = { ti, version };
             auto& slot = self->gpu_sro_table.tlas_slots.unsafe_get(id);
@@ -682,24 +900,25 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
             {
                 continue;
             }
+            auto& cold_slot = self->gpu_sro_table.tlas_slots.unsafe_get_cold(id);
 
             u32 out_idx = report->tlas_count++;
-            report->total_aliased_tlas_device_memory_use += slot.info.size;
+            report->total_aliased_tlas_device_memory_use += cold_slot.info.size;
     
             if (report->tlas_list != nullptr && out_idx < tlas_list_allocation_size)
             {
                 report->tlas_list[out_idx] = {
                     std::bit_cast<daxa_TlasId>(id),
-                    slot.info.size
+                    cold_slot.info.size
                 };
             }
         }
     }
     
-    for (u32 bli = 0; bli < self->gpu_sro_table.blas_slots.next_index; ++bli)
+    for (u32 bli = 0; bli < self->gpu_sro_table.blas_slots.next_index.load(std::memory_order_relaxed); ++bli)
     {
         u64 version = self->gpu_sro_table.blas_slots.version_of_slot(bli);
-        if ((version & GpuResourcePool<u32>::VERSION_ZOMBIE_BIT) == 0) 
+        if ((version & GpuResourcePool<u32, u32>::VERSION_ZOMBIE_BIT) == 0) 
         {
             daxa::BlasId id = { bli, version };
             auto& slot = self->gpu_sro_table.blas_slots.unsafe_get(id);
@@ -707,15 +926,16 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
             {
                 continue;
             }
+            auto& cold_slot = self->gpu_sro_table.blas_slots.unsafe_get_cold(id);
 
             u32 out_idx = report->blas_count++;
-            report->total_aliased_blas_device_memory_use += slot.info.size;
+            report->total_aliased_blas_device_memory_use += cold_slot.info.size;
     
             if (report->blas_list != nullptr && out_idx < blas_list_allocation_size)
             {
                 report->blas_list[out_idx] = {
                     std::bit_cast<daxa_BlasId>(id),
-                    slot.info.size
+                    cold_slot.info.size
                 };
             }
         }
@@ -746,6 +966,58 @@ auto daxa_dvc_device_memory_report(daxa_Device self, daxa_DeviceMemoryReport * r
     return DAXA_RESULT_SUCCESS;
 } 
 
+auto daxa_dvc_stats(daxa_Device self, daxa_DeviceStats * out_stats) -> daxa_Result
+{
+    if (out_stats == nullptr)
+    {
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_UNKNOWN, DAXA_RESULT_ERROR_UNKNOWN);
+    }
+
+    auto pool_stats = [](auto const & pool, u64 zombies) -> daxa_ResourcePoolStats
+    {
+        u64 const created = pool.created_count.load();
+        u64 const destroyed = pool.destroyed_count.load();
+        return daxa_ResourcePoolStats{
+            .capacity = pool.max_resources.load(std::memory_order_relaxed),
+            .live_slots = static_cast<u32>(created > destroyed ? created - destroyed : 0),
+            .free_slots = pool.free_index_count.load(std::memory_order_relaxed),
+            .retired_slots = pool.retired_count.load(std::memory_order_relaxed),
+            .created = created,
+            .destroyed = destroyed,
+            .zombies = zombies,
+        };
+    };
+
+    auto & table = self->gpu_sro_table;
+    *out_stats = {};
+    out_stats->buffers = pool_stats(table.buffer_slots, self->buffer_zombies.pending_count());
+    // Image views share the image pool.
+    out_stats->images = pool_stats(table.image_slots, self->image_zombies.pending_count() + self->image_view_zombies.pending_count());
+    out_stats->samplers = pool_stats(table.sampler_slots, self->sampler_zombies.pending_count());
+    out_stats->tlas = pool_stats(table.tlas_slots, self->tlas_zombies.pending_count());
+    out_stats->blas = pool_stats(table.blas_slots, self->blas_zombies.pending_count());
+    out_stats->total_zombies =
+        out_stats->buffers.zombies +
+        out_stats->images.zombies +
+        out_stats->samplers.zombies +
+        out_stats->tlas.zombies +
+        out_stats->blas.zombies +
+        self->command_list_zombies.pending_count() +
+        self->semaphore_zombies.pending_count() +
+        self->split_barrier_zombies.pending_count() +
+        self->pipeline_zombies.pending_count() +
+        self->timeline_query_pool_zombies.pending_count() +
+        self->memory_block_zombies.pending_count() +
+        self->resource_table_zombies.pending_count();
+    out_stats->descriptor_writes = table.descriptor_write_count.load();
+    out_stats->descriptor_write_flushes = table.descriptor_write_flush_count.load(std::memory_order_relaxed);
+    for (u32 i = 0; i < self->queues.size(); ++i)
+    {
+        out_stats->queue_submits[i] = self->queues[i].submit_count.load(std::memory_order_relaxed);
+    }
+    return DAXA_RESULT_SUCCESS;
+}
+
 auto daxa_default_device_score(daxa_DeviceProperties const * c_properties) -> i32
 {
     DeviceProperties const * properties = r_cast<DeviceProperties const *>(c_properties);
@@ -898,6 +1170,75 @@ auto daxa_dvc_create_image(daxa_Device self, daxa_ImageInfo const * info, daxa_I
     return create_image_helper(self, info, out_id, nullptr, 0);
 }
 
+/// Creates many resources of one type, reserving all their slots and queueing all their descriptor writes at once.
+/// Either all resources are created or none; on failure all already created resources are destroyed again.
+template <typename InfoT, typename IdT>
+auto create_resources_batched_helper(daxa_Device self, InfoT const * infos, IdT * out_ids, daxa_u32 count, auto & slot_pool, auto && grow_fn, daxa_Result exceeded_result, auto && create_fn, auto && destroy_fn) -> daxa_Result
+{
+    std::vector<u32> reserved_indices(count);
+    if (!slot_pool.try_reserve_indices_or_grow(std::span{reserved_indices}, grow_fn))
+    {
+        _DAXA_RETURN_IF_ERROR(exceeded_result, exceeded_result);
+    }
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    DescriptorWriteBatch write_batch = {};
+    write_batch.reserve(count);
+    daxa_u32 created_count = 0;
+    for (; created_count < count; ++created_count)
+    {
+        result = create_fn(self, &infos[created_count], &out_ids[created_count], &write_batch, &reserved_indices[created_count]);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            break;
+        }
+    }
+    // Must happen before a potential destroy below, as destruction overwrites the descriptors with null descriptors.
+    self->gpu_sro_table.queue_writes(write_batch);
+    if (result != DAXA_RESULT_SUCCESS)
+    {
+        for (daxa_u32 i = 0; i < created_count; ++i)
+        {
+            [[maybe_unused]] auto const _ignore = destroy_fn(self, out_ids[i]);
+            out_ids[i] = {};
+        }
+        // The failed create may or may not have consumed its index, the following ones never did.
+        for (u32 const index : reserved_indices)
+        {
+            if (index != std::remove_reference_t<decltype(slot_pool)>::CONSUMED_RESERVED_INDEX)
+            {
+                slot_pool.release_reserved_index(index);
+            }
+        }
+    }
+    return result;
+}
+
+auto daxa_dvc_create_buffers(daxa_Device self, daxa_BufferInfo const * infos, daxa_BufferId * out_ids, daxa_u32 count) -> daxa_Result
+{
+    return create_resources_batched_helper(
+        self, infos, out_ids, count,
+        self->gpu_sro_table.buffer_slots,
+        [self](u32 observed_max_buffers)
+        { return self->try_grow_buffer_slots(observed_max_buffers); },
+        DAXA_RESULT_EXCEEDED_MAX_BUFFERS,
+        [](daxa_Device device, daxa_BufferInfo const * info, daxa_BufferId * out_id, DescriptorWriteBatch * write_batch, u32 * reserved_index)
+        { return create_buffer_helper(device, info, out_id, nullptr, 0, write_batch, reserved_index); },
+        daxa_dvc_destroy_buffer);
+}
+
+auto daxa_dvc_create_images(daxa_Device self, daxa_ImageInfo const * infos, daxa_ImageId * out_ids, daxa_u32 count) -> daxa_Result
+{
+    return create_resources_batched_helper(
+        self, infos, out_ids, count,
+        self->gpu_sro_table.image_slots,
+        [self](u32 observed_max_images)
+        { return self->gpu_sro_table.image_slots.try_grow(observed_max_images); },
+        DAXA_RESULT_EXCEEDED_MAX_IMAGES,
+        [](daxa_Device device, daxa_ImageInfo const * info, daxa_ImageId * out_id, DescriptorWriteBatch * write_batch, u32 * reserved_index)
+        { return create_image_helper(device, info, out_id, nullptr, 0, write_batch, reserved_index); },
+        daxa_dvc_destroy_image);
+}
+
 auto daxa_dvc_create_buffer_from_memory_block(daxa_Device self, daxa_MemoryBlockBufferInfo const * info, daxa_BufferId * out_id) -> daxa_Result
 {
     return create_buffer_helper(self, &info->buffer_info, out_id, *info->memory_block, info->offset);
@@ -956,16 +1297,18 @@ auto daxa_dvc_create_blas_from_buffer(daxa_Device self, daxa_BufferBlasInfo cons
         out_id);
 }
 
-auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id) -> daxa_Result
+auto create_image_view_helper(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id, DescriptorWriteBatch * opt_write_batch = nullptr, u32 * opt_reserved_index = nullptr) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
 
-    auto slot_opt = self->gpu_sro_table.image_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index != nullptr
+                        ? self->gpu_sro_table.image_slots.create_reserved_slot(*opt_reserved_index)
+                        : self->gpu_sro_table.image_slots.try_create_slot_or_grow();
     if (!slot_opt.has_value())
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS, DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS);
     }
-    auto [id, image_slot] = slot_opt.value();
+    auto [id, image_slot, image_cold_slot] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -999,17 +1342,20 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
     /// --- End Validation ---
 
     image_slot = {};
+    image_cold_slot = {};
     auto & ret = image_slot.view_slot;
-    ret.info = *info;
-    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret.info.slice, ret.info.image);
-    ret.info.slice = slice;
+    auto & ret_cold = image_cold_slot.view_slot;
+    ret_cold.info = *info;
+    ret.image = info->image;
+    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret_cold.info.slice, ret_cold.info.image);
+    ret_cold.info.slice = slice;
     VkImageViewCreateInfo const vk_image_view_create_info{
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
         .image = parent_image_slot.vk_image,
-        .viewType = static_cast<VkImageViewType>(ret.info.type),
-        .format = *r_cast<VkFormat const *>(&ret.info.format),
+        .viewType = static_cast<VkImageViewType>(info->type),
+        .format = *r_cast<VkFormat const *>(&info->format),
         .components = VkComponentMapping{
             .r = VK_COMPONENT_SWIZZLE_IDENTITY,
             .g = VK_COMPONENT_SWIZZLE_IDENTITY,
@@ -1033,20 +1379,36 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &name_info);
     }
 
+    if (opt_write_batch != nullptr)
+    {
+        opt_write_batch->add_image(ret.vk_image_view, std::bit_cast<ImageUsageFlags>(self->cold_slot(info->image).info.usage), id.index);
+    }
+    else
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
-            ret.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(parent_image_slot.info.usage),
-            id.index);
-        *out_id = std::bit_cast<daxa_ImageViewId>(id);
+        self->gpu_sro_table.queue_image_write(ret.vk_image_view, std::bit_cast<ImageUsageFlags>(self->cold_slot(info->image).info.usage), id.index);
     }
+    *out_id = std::bit_cast<daxa_ImageViewId>(id);
     return result;
 }
 
+auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id) -> daxa_Result
+{
+    return create_image_view_helper(self, info, out_id);
+}
+
+auto daxa_dvc_create_image_views(daxa_Device self, daxa_ImageViewInfo const * infos, daxa_ImageViewId * out_ids, daxa_u32 count) -> daxa_Result
+{
+    return create_resources_batched_helper(
+        self, infos, out_ids, count,
+        self->gpu_sro_table.image_slots,
+        [self](u32 observed_max_images)
+        { return self->gpu_sro_table.image_slots.try_grow(observed_max_images); },
+        DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS,
+        [](daxa_Device device, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id, DescriptorWriteBatch * write_batch, u32 * reserved_index)
+        { return create_image_view_helper(device, info, out_id, write_batch, reserved_index); },
+        daxa_dvc_destroy_image_view);
+}
+
 auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, daxa_SamplerId * out_id) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
@@ -1058,12 +1420,12 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     }
 
     /// --- End Validation ---
-    auto slot_opt = self->gpu_sro_table.sampler_slots.try_create_slot();
+    auto slot_opt = self->gpu_sro_table.sampler_slots.try_create_slot_or_grow();
     if (!slot_opt.has_value())
     {
         return DAXA_RESULT_EXCEEDED_MAX_SAMPLERS;
     }
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -1076,33 +1438,33 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
 
     VkSamplerReductionModeCreateInfo vk_sampler_reduction_mode_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_REDUCTION_MODE_CREATE_INFO,
         .pNext = nullptr,
-        .reductionMode = static_cast<VkSamplerReductionMode>(ret.info.reduction_mode),
+        .reductionMode = static_cast<VkSamplerReductionMode>(info->reduction_mode),
     };
 
     VkSamplerCreateInfo const vk_sampler_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
         .pNext = r_cast<void *>(&vk_sampler_reduction_mode_create_info),
         .flags = {},
-        .magFilter = static_cast<VkFilter>(ret.info.magnification_filter),
-        .minFilter = static_cast<VkFilter>(ret.info.minification_filter),
-        .mipmapMode = static_cast<VkSamplerMipmapMode>(ret.info.mipmap_filter),
-        .addressModeU = static_cast<VkSamplerAddressMode>(ret.info.address_mode_u),
-        .addressModeV = static_cast<VkSamplerAddressMode>(ret.info.address_mode_v),
-        .addressModeW = static_cast<VkSamplerAddressMode>(ret.info.address_mode_w),
-        .mipLodBias = ret.info.mip_lod_bias,
-        .anisotropyEnable = static_cast<VkBool32>(ret.info.enable_anisotropy),
-        .maxAnisotropy = ret.info.max_anisotropy,
-        .compareEnable = static_cast<VkBool32>(ret.info.enable_compare),
-        .compareOp = static_cast<VkCompareOp>(ret.info.compare_op),
-        .minLod = ret.info.min_lod,
-        .maxLod = ret.info.max_lod,
-        .borderColor = static_cast<VkBorderColor>(ret.info.border_color),
-        .unnormalizedCoordinates = static_cast<VkBool32>(ret.info.enable_unnormalized_coordinates),
+        .magFilter = static_cast<VkFilter>(info->magnification_filter),
+        .minFilter = static_cast<VkFilter>(info->minification_filter),
+        .mipmapMode = static_cast<VkSamplerMipmapMode>(info->mipmap_filter),
+        .addressModeU = static_cast<VkSamplerAddressMode>(info->address_mode_u),
+        .addressModeV = static_cast<VkSamplerAddressMode>(info->address_mode_v),
+        .addressModeW = static_cast<VkSamplerAddressMode>(info->address_mode_w),
+        .mipLodBias = info->mip_lod_bias,
+        .anisotropyEnable = static_cast<VkBool32>(info->enable_anisotropy),
+        .maxAnisotropy = info->max_anisotropy,
+        .compareEnable = static_cast<VkBool32>(info->enable_compare),
+        .compareOp = static_cast<VkCompareOp>(info->compare_op),
+        .minLod = info->min_lod,
+        .maxLod = info->max_lod,
+        .borderColor = static_cast<VkBorderColor>(info->border_color),
+        .unnormalizedCoordinates = static_cast<VkBool32>(info->enable_unnormalized_coordinates),
     };
 
     result = static_cast<daxa_Result>(vkCreateSampler(self->vk_device, &vk_sampler_create_info, nullptr, &ret.vk_sampler));
@@ -1121,11 +1483,7 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &sampler_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(self->vk_device, self->gpu_sro_table.vk_descriptor_set, ret.vk_sampler, id.index);
-    }
+    self->gpu_sro_table.queue_sampler_write(ret.vk_sampler, id.index);
     *out_id = std::bit_cast<daxa_SamplerId>(id);
     return result;
 }
@@ -1145,7 +1503,7 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     auto daxa_dvc_info_##name(daxa_Device self, daxa_##Name##Id id, daxa_##Name##Info * out_info)->daxa_Result \
     {                                                                                                          \
         /*NOTE: THIS CAN RACE. BUT IT IS OK AS ITS A POD AND WE CHECK IF ITS VALID AFTER THE COPY!*/           \
-        auto info_copy = self->slot(id).info;                                                                  \
+        auto info_copy = self->cold_slot(id).info;                                                             \
         if (daxa_dvc_is_##name##_valid(self, id))                                                              \
         {                                                                                                      \
             *out_info = info_copy;                                                                             \
@@ -1251,6 +1609,8 @@ auto daxa_dvc_get_vk_queue(daxa_Device self, daxa_Queue queue, VkQueue* vk_queue
 auto daxa_dvc_wait_idle(daxa_Device self) -> daxa_Result
 {
     PROFILE_FUNC();
+    auto const gc_result = self->garbage_collector_result();
+    _DAXA_RETURN_IF_ERROR(gc_result, gc_result)
     return std::bit_cast<daxa_Result>(vkDeviceWaitIdle(self->vk_device));
 }
 
@@ -1280,132 +1640,97 @@ auto daxa_dvc_queue_count(daxa_Device self, daxa_QueueFamily queue_family, u32 *
 
 auto daxa_dvc_submit(daxa_Device self, daxa_CommandSubmitInfo const * info) -> daxa_Result
 {
-    PROFILE_FUNC();
-    if (!self->valid_queue(info->queue))
-    {
-        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
-    }
+    return daxa_dvc_submit_batch(self, info, 1);
+}
 
-    std::shared_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+auto daxa_dvc_submit_batch(daxa_Device self, daxa_CommandSubmitInfo const * infos, u64 info_count) -> daxa_Result
+{
+    PROFILE_FUNC();
+    auto const gc_result = self->garbage_collector_result();
+    _DAXA_RETURN_IF_ERROR(gc_result, gc_result)
+    std::span<daxa_CommandSubmitInfo const> const submit_infos = {infos, info_count};
 
-    if (static_cast<u32>(info->queue.index) >= self->queue_families[info->queue.family].queue_count)
+    for (usize i = 0; i < submit_infos.size(); ++i)
     {
-        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
+        auto result = validate_submit_info(self, submit_infos[i]);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            for (auto const & info : submit_infos.subspan(0, i))
+            {
+                release_submit_claims(info, info.command_list_count);
+            }
+        }
+        _DAXA_RETURN_IF_ERROR(result, result)
     }
 
-    for (daxa_ExecutableCommandList commands : std::span{info->command_lists, info->command_list_count})
+    // Descriptors of all resources used in the submitted commands must be written before the gpu can execute them.
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
+
+    // Deferred destructions zombify with the current submit timeline value.
+    // That must happen after the submits got their values, otherwise the zombies could be destroyed before the submits finished.
+    auto const execute_deferred_destructions = [&](std::span<daxa_CommandSubmitInfo const> submitted_infos)
     {
-        if (commands->cmd_recorder->info.queue_family != info->queue.family)
-        {
-            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
-        }
-        for (BufferId id : commands->data.used_buffers)
+        for (auto const & info : submitted_infos)
         {
-            if (!daxa_dvc_is_buffer_valid(self, id))
+            for (auto const & commands : std::span{info.command_lists, info.command_list_count})
             {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID);
+                // Reusable lists execute their deferred destructions when they are destroyed.
+                if (commands->cmd_recorder->info.reusable_command_lists == 0)
+                {
+                    executable_cmd_list_execute_deferred_destructions(self, commands->data);
+                }
             }
         }
-        for (ImageId id : commands->data.used_images)
+    };
+
+    // Submits keep the order of the batch, each run of consecutive submits to one queue is issued with a single vkQueueSubmit2.
+    // Reordering across queues could make a binary semaphore wait get submitted before its signal.
+    // Each logical submit still signals its own queue timeline value, zombies are tracked per logical submit.
+    SubmitScratch & scratch = tl_submit_scratch;
+    for (usize run_begin = 0; run_begin < submit_infos.size();)
+    {
+        daxa_ImplDevice::ImplQueue & queue = self->get_queue(submit_infos[run_begin].queue);
+        usize run_end = run_begin + 1;
+        while (run_end < submit_infos.size() && &self->get_queue(submit_infos[run_end].queue) == &queue)
         {
-            if (!daxa_dvc_is_image_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID);
-            }
+            ++run_end;
         }
-        for (ImageViewId id : commands->data.used_image_views)
+
+        scratch.clear();
+        for (usize i = run_begin; i < run_end; ++i)
         {
-            if (!daxa_dvc_is_image_view_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID);
-            }
+            scratch.reserve(submit_infos[i]);
+        }
+        // The queue must look busy to the garbage collector before the values are taken, see collect_garbage_helper.
+        queue.submits_in_flight.fetch_add(1, std::memory_order::seq_cst);
+        u64 latest_timeline_value = {};
+        for (usize i = run_begin; i < run_end; ++i)
+        {
+            latest_timeline_value = self->global_submit_timeline.fetch_add(1, std::memory_order::seq_cst) + 1;
+            append_submit_info(scratch, submit_infos[i], queue.gpu_queue_local_timeline, latest_timeline_value);
         }
-        for (SamplerId id : commands->data.used_samplers)
+        queue.latest_pending_submit_timeline_value.store(latest_timeline_value, std::memory_order::seq_cst);
+        queue.submits_in_flight.fetch_sub(1, std::memory_order::seq_cst);
+
+        auto result = static_cast<daxa_Result>(vkQueueSubmit2(queue.vk_queue, static_cast<u32>(scratch.submits.size()), scratch.submits.data(), VK_NULL_HANDLE));
+        if (result != DAXA_RESULT_SUCCESS)
         {
-            if (!daxa_dvc_is_sampler_valid(self, id))
+            // Lists of this run and all runs after it never reached the gpu, the ones before did.
+            for (auto const & info : submit_infos.subspan(run_begin))
             {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID);
+                release_submit_claims(info, info.command_list_count);
             }
+            execute_deferred_destructions(submit_infos.subspan(0, run_begin));
         }
+        _DAXA_RETURN_IF_ERROR(result, result)
+        queue.submit_count.fetch_add(scratch.submits.size(), std::memory_order_relaxed);
+        run_begin = run_end;
     }
 
-    daxa_ImplDevice::ImplQueue & queue = self->get_queue(info->queue);
-    u64 const current_timeline_value = self->global_submit_timeline.fetch_add(1) + 1;
-    queue.latest_pending_submit_timeline_value.store(current_timeline_value);
-
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
-    {
-        executable_cmd_list_execute_deferred_destructions(self, commands->data);
-    }
-
-    std::vector<VkCommandBuffer> submit_vk_command_buffers = {};
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
-    {
-        submit_vk_command_buffers.push_back(commands->data.vk_cmd_buffer);
-    }
-
-    std::vector<VkSemaphore> submit_semaphore_signals = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<u64> submit_semaphore_signal_values = {};   // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
-
-    // Add main queue timeline signaling as first timeline semaphore signaling:
-    submit_semaphore_signals.push_back(queue.gpu_queue_local_timeline);
-    submit_semaphore_signal_values.push_back(current_timeline_value);
-
-    for (auto const & pair : std::span{info->signal_timeline_semaphores, info->signal_timeline_semaphore_count})
-    {
-        submit_semaphore_signals.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(pair.value);
-    }
-
-    for (auto const & binary_semaphore : std::span{info->signal_binary_semaphores, info->signal_binary_semaphore_count})
-    {
-        submit_semaphore_signals.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(0); // The vulkan spec requires to have dummy values for binary semaphores.
-    }
-
-    // used to synchronize with previous submits:
-    std::vector<VkSemaphore> submit_semaphore_waits = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<VkPipelineStageFlags> submit_semaphore_wait_stage_masks = {};
-    std::vector<u64> submit_semaphore_wait_values = {}; // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
-
-    for (auto const & pair : std::span{info->wait_timeline_semaphores, info->wait_timeline_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(pair.value);
-    }
-
-    for (auto const & binary_semaphore : std::span{info->wait_binary_semaphores, info->wait_binary_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(0);
-    }
-
-    VkTimelineSemaphoreSubmitInfo timeline_info{
-        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
-        .pNext = nullptr,
-        .waitSemaphoreValueCount = static_cast<u32>(submit_semaphore_wait_values.size()),
-        .pWaitSemaphoreValues = submit_semaphore_wait_values.data(),
-        .signalSemaphoreValueCount = static_cast<u32>(submit_semaphore_signal_values.size()),
-        .pSignalSemaphoreValues = submit_semaphore_signal_values.data(),
-    };
-
-    VkSubmitInfo const vk_submit_info{
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext = r_cast<void *>(&timeline_info),
-        .waitSemaphoreCount = static_cast<u32>(submit_semaphore_waits.size()),
-        .pWaitSemaphores = submit_semaphore_waits.data(),
-        .pWaitDstStageMask = submit_semaphore_wait_stage_masks.data(),
-        .commandBufferCount = static_cast<u32>(submit_vk_command_buffers.size()),
-        .pCommandBuffers = submit_vk_command_buffers.data(),
-        .signalSemaphoreCount = static_cast<u32>(submit_semaphore_signals.size()),
-        .pSignalSemaphores = submit_semaphore_signals.data(),
-    };
-    auto result = static_cast<daxa_Result>(vkQueueSubmit(queue.vk_queue, 1, &vk_submit_info, VK_NULL_HANDLE));
-    _DAXA_RETURN_IF_ERROR(result, result)
+    execute_deferred_destructions(submit_infos);
 
-    std::unique_lock const lock{self->zombies_mtx};
+    // Wakes up an idle garbage collector, so that it starts waiting on the new submits.
+    self->notify_garbage_collector();
 
     return DAXA_RESULT_SUCCESS;
 }
@@ -1413,6 +1738,8 @@ auto daxa_dvc_submit(daxa_Device self, daxa_CommandSubmitInfo const * info) -> d
 auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_Result
 {
     PROFILE_FUNC();
+    auto const gc_result = self->garbage_collector_result();
+    _DAXA_RETURN_IF_ERROR(gc_result, gc_result)
     if (info->queue.family != static_cast<daxa_QueueFamily>(info->swapchain->info.queue_family))
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_PRESENT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_PRESENT_QUEUE_FAMILY_MISMATCH)
@@ -1444,12 +1771,15 @@ auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_R
     return std::bit_cast<daxa_Result>(result);
 }
 
-auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
+auto collect_garbage_helper(daxa_Device self, daxa_GarbageCollectBudget const & budget, u64 * out_remaining_zombies) -> daxa_Result
 {
-    PROFILE_FUNC();
-    std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+    auto const start_time = std::chrono::steady_clock::now();
     std::unique_lock lock{self->zombies_mtx};
 
+    // Read before the queues, so that submits racing with the queries are never considered finished.
+    // Every submit up to this value is either pending or in flight on its queue when the queues are read below.
+    // Submits and zombies after this value are invisible to this pass, so nothing younger than it is collected.
+    u64 const submitted_timeline_value = self->global_submit_timeline.load(std::memory_order::seq_cst);
     u64 min_pending_device_timeline_value_of_all_queues = std::numeric_limits<u64>::max();
     for (auto & queue : self->queues)
     {
@@ -1462,20 +1792,47 @@ auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
             min_pending_device_timeline_value_of_all_queues = std::min(min_pending_device_timeline_value_of_all_queues, latest_pending_submit.value());
         }
     }
+    // Lets the thread command pool caches recycle their pools without the garbage collector.
+    u64 const finished_timeline_value = std::min(min_pending_device_timeline_value_of_all_queues - 1, submitted_timeline_value);
+    u64 known_finished_timeline_value = self->finished_submit_timeline_value.load(std::memory_order::relaxed);
+    while (known_finished_timeline_value < finished_timeline_value &&
+           !self->finished_submit_timeline_value.compare_exchange_weak(known_finished_timeline_value, finished_timeline_value, std::memory_order::relaxed))
+    {
+    }
+
+    // Once the budget is used up, all following zombies are left for later calls.
+    // Zombies of later lists can depend on older zombies of earlier lists (memory blocks on buffers), so the order must be kept.
+    u32 destroyed_objects = 0;
+    bool budget_exhausted = false;
+    auto try_consume_budget = [&]() -> bool
+    {
+        budget_exhausted =
+            budget_exhausted ||
+            (budget.max_destroyed_objects != 0 && destroyed_objects >= budget.max_destroyed_objects) ||
+            (budget.max_microseconds != 0 && std::chrono::steady_clock::now() - start_time >= std::chrono::microseconds{budget.max_microseconds});
+        if (!budget_exhausted)
+        {
+            ++destroyed_objects;
+        }
+        return !budget_exhausted;
+    };
 
     auto check_and_cleanup_gpu_resources = [&](auto & zombies, auto const & cleanup_fn)
     {
-        while (!zombies.empty())
+        zombies.merge();
+        // Read after the merge, so that every recorder that could have referenced a merged zombie before its destruction is seen.
+        u64 const collectable_timeline_value = std::min({min_pending_device_timeline_value_of_all_queues, self->recorder_epochs.oldest(), submitted_timeline_value + 1});
+        while (!zombies.collected.empty())
         {
-            auto & [timeline_value, object] = zombies.back();
+            auto & [timeline_value, object] = zombies.collected.front();
 
-            if (timeline_value >= min_pending_device_timeline_value_of_all_queues)
+            if (timeline_value >= collectable_timeline_value || !try_consume_budget())
             {
                 break;
             }
 
             cleanup_fn(object);
-            zombies.pop_back();
+            zombies.pop_front();
         }
     };
     check_and_cleanup_gpu_resources(
@@ -1544,31 +1901,79 @@ auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
         {
             vmaFreeMemory(self->vma_allocator, memory_block_zombie.allocation);
         });
+    check_and_cleanup_gpu_resources(
+        self->resource_table_zombies,
+        [&](auto & resource_table_zombie)
+        {
+            vmaDestroyBuffer(self->vma_allocator, resource_table_zombie.buffer_device_address_buffer, resource_table_zombie.buffer_device_address_buffer_allocation);
+            if (resource_table_zombie.table_storage.vk_descriptor_pool != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorPool(self->vk_device, resource_table_zombie.table_storage.vk_descriptor_pool, nullptr);
+            }
+            if (resource_table_zombie.table_storage.descriptor_buffer != VK_NULL_HANDLE)
+            {
+                vmaDestroyBuffer(self->vma_allocator, resource_table_zombie.table_storage.descriptor_buffer, resource_table_zombie.table_storage.descriptor_buffer_allocation);
+            }
+        });
+    // Writes the null descriptors of all cleaned up resources.
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
     {
-        std::unique_lock const main_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_MAIN].mtx};
-        std::unique_lock const compute_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_COMPUTE].mtx};
-        std::unique_lock const transfer_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_TRANSFER].mtx};
-        while (!self->command_list_zombies.empty())
+        self->command_list_zombies.merge();
+        u64 const collectable_timeline_value = std::min(min_pending_device_timeline_value_of_all_queues, submitted_timeline_value + 1);
+        while (!self->command_list_zombies.collected.empty())
         {
-            auto & [timeline_value, zombie] = self->command_list_zombies.back();
+            auto & [timeline_value, zombie] = self->command_list_zombies.collected.front();
 
             // Zombies are sorted. When we see a single zombie that is too young, we can dismiss the rest as they are the same age or even younger.
-            if (timeline_value >= min_pending_device_timeline_value_of_all_queues)
+            if (timeline_value >= collectable_timeline_value || !try_consume_budget())
             {
                 break;
             }
 
-            vkFreeCommandBuffers(self->vk_device, zombie.vk_cmd_pool, static_cast<u32>(zombie.allocated_command_buffers.size()), zombie.allocated_command_buffers.data());
-            auto result = static_cast<daxa_Result>(vkResetCommandPool(self->vk_device, zombie.vk_cmd_pool, {}));
+            // The command buffers stay allocated, they are reused by the next recorder that gets the pool.
+            auto result = static_cast<daxa_Result>(vkResetCommandPool(self->vk_device, zombie.pool.vk_cmd_pool, {}));
             _DAXA_RETURN_IF_ERROR(result, result)
 
-            self->command_pool_pools[zombie.queue_family].put_back(zombie.vk_cmd_pool);
-            self->command_list_zombies.pop_back();
+            {
+                std::unique_lock const pool_lock{self->command_pool_pools[zombie.queue_family].mtx};
+                self->command_pool_pools[zombie.queue_family].put_back(std::move(zombie.pool));
+            }
+            self->command_list_zombies.pop_front();
         }
     }
+    if (out_remaining_zombies != nullptr)
+    {
+        *out_remaining_zombies =
+            self->command_list_zombies.size() +
+            self->buffer_zombies.size() +
+            self->image_zombies.size() +
+            self->image_view_zombies.size() +
+            self->sampler_zombies.size() +
+            self->tlas_zombies.size() +
+            self->blas_zombies.size() +
+            self->semaphore_zombies.size() +
+            self->split_barrier_zombies.size() +
+            self->pipeline_zombies.size() +
+            self->timeline_query_pool_zombies.size() +
+            self->memory_block_zombies.size() +
+            self->resource_table_zombies.size();
+    }
     return DAXA_RESULT_SUCCESS;
 }
 
+auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
+{
+    return daxa_dvc_collect_garbage_budgeted(self, &DAXA_DEFAULT_GARBAGE_COLLECT_BUDGET, nullptr);
+}
+
+auto daxa_dvc_collect_garbage_budgeted(daxa_Device self, daxa_GarbageCollectBudget const * budget, u64 * out_remaining_zombies) -> daxa_Result
+{
+    PROFILE_FUNC();
+    auto const gc_result = self->garbage_collector_result();
+    _DAXA_RETURN_IF_ERROR(gc_result, gc_result)
+    return collect_garbage_helper(self, *budget, out_remaining_zombies);
+}
+
 auto daxa_dvc_properties(daxa_Device device) -> daxa_DeviceProperties const *
 {
     return &device->properties;
@@ -1601,24 +2006,31 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
     auto self = out_device;
     self->vk_physical_device = physical_device.vk_handle;
     self->properties = properties;
+    static std::atomic_uint64_t device_serial_counter = {};
+    self->serial = device_serial_counter.fetch_add(1, std::memory_order::relaxed) + 1;
     self->instance = instance;
     self->info = std::bit_cast<DeviceInfo2>(info);
+    // Growth limits below the initial limits disable growth.
+    self->info.max_growable_buffers = std::max(self->info.max_growable_buffers, self->info.max_allowed_buffers);
+    self->info.max_growable_images = std::max(self->info.max_growable_images, self->info.max_allowed_images);
+    self->info.max_growable_samplers = std::max(self->info.max_growable_samplers, self->info.max_allowed_samplers);
 
     // Verify DeviceOptions:
-    if (self->info.max_allowed_buffers > self->properties.limits.max_descriptor_set_storage_buffers || self->info.max_allowed_buffers == 0)
+    // The resource table layout is sized for the growth limits.
+    if (self->info.max_growable_buffers > self->properties.limits.max_descriptor_set_storage_buffers || self->info.max_allowed_buffers == 0)
     {
         result = DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_BUFFER_COUNT;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
     auto const max_device_supported_images_in_set = std::min(self->properties.limits.max_descriptor_set_sampled_images, self->properties.limits.max_descriptor_set_storage_images);
-    if (self->info.max_allowed_buffers > max_device_supported_images_in_set || self->info.max_allowed_buffers == 0)
+    if (self->info.max_growable_images > max_device_supported_images_in_set || self->info.max_allowed_images == 0)
     {
         result = DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_IMAGE_COUNT;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    if (self->info.max_allowed_samplers > self->properties.limits.max_descriptor_set_samplers || self->info.max_allowed_samplers == 0)
+    if (self->info.max_growable_samplers > self->properties.limits.max_descriptor_set_samplers || self->info.max_allowed_samplers == 0)
     {
         result = DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_SAMPLER_COUNT;
     }
@@ -1760,6 +2172,11 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
             self->vkCmdSetRasterizationSamplesEXT = r_cast<PFN_vkCmdSetRasterizationSamplesEXT>(vkGetDeviceProcAddr(self->vk_device, "vkCmdSetRasterizationSamplesEXT"));
         }
 
+        if (properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW)
+        {
+            self->vkCmdDrawMultiIndexedEXT = r_cast<PFN_vkCmdDrawMultiIndexedEXT>(vkGetDeviceProcAddr(self->vk_device, "vkCmdDrawMultiIndexedEXT"));
+        }
+
         if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE)
         {
             self->vkSetDebugUtilsObjectNameEXT = r_cast<PFN_vkSetDebugUtilsObjectNameEXT>(vkGetDeviceProcAddr(self->vk_device, "vkSetDebugUtilsObjectNameEXT"));
@@ -1791,6 +2208,23 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
             self->vkCmdTraceRaysIndirectKHR = r_cast<PFN_vkCmdTraceRaysIndirectKHR>(vkGetDeviceProcAddr(self->vk_device, "vkCmdTraceRaysIndirectKHR"));
             self->vkGetRayTracingShaderGroupHandlesKHR = r_cast<PFN_vkGetRayTracingShaderGroupHandlesKHR>(vkGetDeviceProcAddr(self->vk_device, "vkGetRayTracingShaderGroupHandlesKHR"));
         }
+
+        if (properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER)
+        {
+            self->vkGetDescriptorSetLayoutSizeEXT = r_cast<PFN_vkGetDescriptorSetLayoutSizeEXT>(vkGetDeviceProcAddr(self->vk_device, "vkGetDescriptorSetLayoutSizeEXT"));
+            self->vkGetDescriptorSetLayoutBindingOffsetEXT = r_cast<PFN_vkGetDescriptorSetLayoutBindingOffsetEXT>(vkGetDeviceProcAddr(self->vk_device, "vkGetDescriptorSetLayoutBindingOffsetEXT"));
+            self->vkGetDescriptorEXT = r_cast<PFN_vkGetDescriptorEXT>(vkGetDeviceProcAddr(self->vk_device, "vkGetDescriptorEXT"));
+            self->vkCmdBindDescriptorBuffersEXT = r_cast<PFN_vkCmdBindDescriptorBuffersEXT>(vkGetDeviceProcAddr(self->vk_device, "vkCmdBindDescriptorBuffersEXT"));
+            self->vkCmdSetDescriptorBufferOffsetsEXT = r_cast<PFN_vkCmdSetDescriptorBufferOffsetsEXT>(vkGetDeviceProcAddr(self->vk_device, "vkCmdSetDescriptorBufferOffsetsEXT"));
+
+            self->descriptor_buffer_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+            VkPhysicalDeviceProperties2 vk_properties_2{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                .pNext = &self->descriptor_buffer_properties,
+                .properties = {},
+            };
+            vkGetPhysicalDeviceProperties2(self->vk_physical_device, &vk_properties_2);
+        }
     }
 
     VkCommandPool init_cmd_pool = {};
@@ -1927,7 +2361,7 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
             .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
             .pNext = nullptr,
             .flags = {},
-            .size = sizeof(u8) * 4,
+            .size = NULL_BUFFER_SIZE,
             .usage = create_buffer_use_flags(self),
             .sharingMode = VK_SHARING_MODE_CONCURRENT,
             .queueFamilyIndexCount = self->valid_vk_queue_family_count,
@@ -1969,6 +2403,13 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
 
         *static_cast<decltype(buffer_data) *>(vma_allocation_info.pMappedData) = buffer_data;
 
+        VkBufferDeviceAddressInfo const null_buffer_device_address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = self->vk_null_buffer,
+        };
+        self->vk_null_buffer_device_address = vkGetBufferDeviceAddress(self->vk_device, &null_buffer_device_address_info);
+
         auto image_info = ImageInfo{
             .dimensions = 2,
             .format = Format::R8G8B8A8_UNORM,
@@ -2122,37 +2563,10 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
             self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &sampler_name_info);
         }
 
-        VkBufferUsageFlags const usage_flags =
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-
-        VkBufferCreateInfo const bda_buffer_create_info{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = {},
-            .size = self->info.max_allowed_buffers * sizeof(u64),
-            .usage = usage_flags,
-            .sharingMode = VK_SHARING_MODE_CONCURRENT,                  // Buffers are always shared.
-            .queueFamilyIndexCount = self->valid_vk_queue_family_count, // Buffers are always shared across all queues.
-            .pQueueFamilyIndices = self->valid_vk_queue_families.data(),
-        };
-
-        VmaAllocationCreateInfo const bda_allocation_create_info{
-            .flags = static_cast<VmaAllocationCreateFlags>(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT),
-            .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-            .requiredFlags = {},
-            .preferredFlags = {},
-            .memoryTypeBits = std::numeric_limits<u32>::max(),
-            .pool = nullptr,
-            .pUserData = nullptr,
-            .priority = 0.5f,
-        };
-
-        result = static_cast<daxa_Result>(vmaCreateBuffer(self->vma_allocator, &bda_buffer_create_info, &bda_allocation_create_info, &self->buffer_device_address_buffer, &self->buffer_device_address_buffer_allocation, nullptr));
-        _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_BDA_BUFFER)
-        result = static_cast<daxa_Result>(vmaMapMemory(self->vma_allocator, self->buffer_device_address_buffer_allocation, r_cast<void **>(&self->buffer_device_address_buffer_host_ptr)));
-        _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_BDA_BUFFER)
+        u64 * buffer_device_address_buffer_host_ptr = {};
+        result = self->create_buffer_device_address_buffer(self->info.max_allowed_buffers, self->buffer_device_address_buffer, self->buffer_device_address_buffer_allocation, buffer_device_address_buffer_host_ptr);
+        _DAXA_RETURN_IF_ERROR(result, result)
+        self->buffer_device_address_buffer_host_ptr.store(buffer_device_address_buffer_host_ptr, std::memory_order_relaxed);
     }
 
     // Set debug names:
@@ -2209,14 +2623,31 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
         }
     }
 
+    // The descriptor buffer backend is preferred when available, it skips vkUpdateDescriptorSets entirely.
+    DescriptorBufferInitInfo const descriptor_buffer_init_info{
+        .vma_allocator = self->vma_allocator,
+        .properties = &self->descriptor_buffer_properties,
+        .robust_buffer_access = (info.explicit_features & DAXA_EXPLICIT_FEATURE_FLAG_ROBUSTNESS_2) != 0,
+        .queue_family_count = self->valid_vk_queue_family_count,
+        .queue_families = self->valid_vk_queue_families.data(),
+        .vkGetDescriptorSetLayoutSizeEXT = self->vkGetDescriptorSetLayoutSizeEXT,
+        .vkGetDescriptorSetLayoutBindingOffsetEXT = self->vkGetDescriptorSetLayoutBindingOffsetEXT,
+        .vkGetDescriptorEXT = self->vkGetDescriptorEXT,
+        .vkCmdBindDescriptorBuffersEXT = self->vkCmdBindDescriptorBuffersEXT,
+        .vkCmdSetDescriptorBufferOffsetsEXT = self->vkCmdSetDescriptorBufferOffsetsEXT,
+    };
     result = self->gpu_sro_table.initialize(
         self->info.max_allowed_buffers,
         self->info.max_allowed_images,
         self->info.max_allowed_samplers,
         (properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_BASIC_RAY_TRACING) ? self->info.max_allowed_acceleration_structures : (~0u),
+        self->info.max_growable_buffers,
+        self->info.max_growable_images,
+        self->info.max_growable_samplers,
         self->vk_device,
         self->buffer_device_address_buffer,
-        self->vkSetDebugUtilsObjectNameEXT);
+        self->vkSetDebugUtilsObjectNameEXT,
+        (properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER) ? &descriptor_buffer_init_info : nullptr);
     _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_SUBMIT_DEVICE_INIT_COMMANDS)
 
     result = static_cast<daxa_Result>(vkEndCommandBuffer(init_cmd_buffer));
@@ -2242,9 +2673,287 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
     result = static_cast<daxa_Result>(vkDeviceWaitIdle(self->vk_device));
     _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_SUBMIT_DEVICE_INIT_COMMANDS)
 
+    if (self->info.enable_background_garbage_collection != 0)
+    {
+        self->garbage_collector_thread = std::thread{&daxa_ImplDevice::garbage_collector_loop, self};
+    }
+
     return DAXA_RESULT_SUCCESS;
 }
 
+void daxa_ImplDevice::garbage_collector_loop()
+{
+    std::array<VkSemaphore, std::tuple_size_v<decltype(queues)>> wait_semaphores = {};
+    std::array<u64, std::tuple_size_v<decltype(queues)>> wait_values = {};
+    // Errors are not recoverable here, retrying would only spin on them.
+    auto const stop_on_error = [&](daxa_Result result) -> bool
+    {
+        if (result == DAXA_RESULT_SUCCESS)
+        {
+            return false;
+        }
+        this->garbage_collector_error.store(result, std::memory_order_release);
+        return true;
+    };
+    while (true)
+    {
+        {
+            std::unique_lock lock{this->garbage_collector_mtx};
+            if (this->garbage_collector_stop)
+            {
+                return;
+            }
+        }
+
+        // Wait until any queue retires its oldest pending submit.
+        u32 wait_count = 0;
+        for (auto & queue : this->queues)
+        {
+            std::optional<u64> latest_retired_submit = {};
+            if (stop_on_error(queue.get_oldest_pending_submit(this->vk_device, latest_retired_submit)))
+            {
+                return;
+            }
+            if (latest_retired_submit.has_value())
+            {
+                wait_semaphores.at(wait_count) = queue.gpu_queue_local_timeline;
+                wait_values.at(wait_count) = latest_retired_submit.value() + 1;
+                ++wait_count;
+            }
+        }
+        if (wait_count > 0)
+        {
+            VkSemaphoreWaitInfo const wait_info{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                .pNext = nullptr,
+                .flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+                .semaphoreCount = wait_count,
+                .pSemaphores = wait_semaphores.data(),
+                .pValues = wait_values.data(),
+            };
+            // Times out regularly, to pick up zombies that do not depend on any submit.
+            auto const wait_result = vkWaitSemaphores(this->vk_device, &wait_info, GARBAGE_COLLECTOR_WAIT_TIMEOUT_NANOS);
+            if (wait_result != VK_TIMEOUT && stop_on_error(static_cast<daxa_Result>(wait_result)))
+            {
+                return;
+            }
+        }
+        else
+        {
+            std::unique_lock lock{this->garbage_collector_mtx};
+            this->garbage_collector_cv.wait(
+                lock,
+                [&]()
+                {
+                    return this->garbage_collector_stop || this->garbage_collector_work_pending.load(std::memory_order_relaxed);
+                });
+        }
+
+        // Cleared before collecting, zombies pushed during the collection wake the thread up again.
+        this->garbage_collector_work_pending.store(false, std::memory_order_relaxed);
+        if (stop_on_error(collect_garbage_helper(this, DAXA_DEFAULT_GARBAGE_COLLECT_BUDGET, nullptr)))
+        {
+            return;
+        }
+    }
+}
+
+auto daxa_ImplDevice::garbage_collector_result() const -> daxa_Result
+{
+    return this->garbage_collector_error.load(std::memory_order_acquire);
+}
+
+void daxa_ImplDevice::stop_garbage_collector()
+{
+    if (!this->garbage_collector_thread.joinable())
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{this->garbage_collector_mtx};
+        this->garbage_collector_stop = true;
+    }
+    this->garbage_collector_cv.notify_one();
+    this->garbage_collector_thread.join();
+}
+
+void daxa_ImplDevice::notify_garbage_collector()
+{
+    if (!this->garbage_collector_thread.joinable())
+    {
+        return;
+    }
+    // Only the first notification after a collection needs to wake the thread.
+    if (!this->garbage_collector_work_pending.exchange(true, std::memory_order_relaxed))
+    {
+        // Locking orders the flag with the check in the wait predicate, so the wakeup can not get lost.
+        {
+            std::unique_lock lock{this->garbage_collector_mtx};
+        }
+        this->garbage_collector_cv.notify_one();
+    }
+}
+
+auto daxa_ImplDevice::thread_command_pool_cache() -> ThreadCommandPoolCache *
+{
+    if (std::this_thread::get_id() == this->garbage_collector_thread.get_id())
+    {
+        return nullptr;
+    }
+    struct ThreadCacheRef
+    {
+        u64 device_serial = {};
+        ThreadCommandPoolCache * cache = {};
+        // Expires when the owning device is destroyed.
+        std::weak_ptr<ThreadCommandPoolCache> owner = {};
+    };
+    thread_local std::vector<ThreadCacheRef> thread_caches = {};
+    // Drops the entries of destroyed devices, long lived threads would accumulate them otherwise.
+    std::erase_if(thread_caches, [](ThreadCacheRef const & ref)
+                  { return ref.owner.expired(); });
+    for (auto const & ref : thread_caches)
+    {
+        if (ref.device_serial == this->serial)
+        {
+            return ref.cache;
+        }
+    }
+    std::shared_ptr<ThreadCommandPoolCache> cache = std::make_shared<ThreadCommandPoolCache>();
+    {
+        std::unique_lock const lock{this->thread_command_pool_caches_mtx};
+        this->thread_command_pool_caches.push_back(cache);
+    }
+    thread_caches.push_back(ThreadCacheRef{.device_serial = this->serial, .cache = cache.get(), .owner = cache});
+    return cache.get();
+}
+
+auto daxa_ImplDevice::create_buffer_device_address_buffer(u32 buffer_count, VkBuffer & out_buffer, VmaAllocation & out_allocation, u64 *& out_host_ptr) -> daxa_Result
+{
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    VkBufferUsageFlags const usage_flags =
+        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+    VkBufferCreateInfo const bda_buffer_create_info{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .size = buffer_count * sizeof(u64),
+        .usage = usage_flags,
+        .sharingMode = VK_SHARING_MODE_CONCURRENT,                  // Buffers are always shared.
+        .queueFamilyIndexCount = this->valid_vk_queue_family_count, // Buffers are always shared across all queues.
+        .pQueueFamilyIndices = this->valid_vk_queue_families.data(),
+    };
+
+    VmaAllocationCreateInfo const bda_allocation_create_info{
+        .flags = static_cast<VmaAllocationCreateFlags>(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT),
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        .requiredFlags = {},
+        .preferredFlags = {},
+        .memoryTypeBits = std::numeric_limits<u32>::max(),
+        .pool = nullptr,
+        .pUserData = nullptr,
+        .priority = 0.5f,
+    };
+
+    result = static_cast<daxa_Result>(vmaCreateBuffer(this->vma_allocator, &bda_buffer_create_info, &bda_allocation_create_info, &out_buffer, &out_allocation, nullptr));
+    _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_BDA_BUFFER)
+    result = static_cast<daxa_Result>(vmaMapMemory(this->vma_allocator, out_allocation, r_cast<void **>(&out_host_ptr)));
+    _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_BDA_BUFFER)
+    return result;
+}
+
+auto daxa_ImplDevice::try_grow_buffer_slots(u32 observed_max_buffers) -> bool
+{
+    auto & buffer_slots = this->gpu_sro_table.buffer_slots;
+    ResourceTableZombie zombie = {};
+    {
+        std::unique_lock const lock{this->resource_table_growth_mtx};
+        if (buffer_slots.max_resources.load(std::memory_order_relaxed) != observed_max_buffers)
+        {
+            // Grown by a concurrent call.
+            return true;
+        }
+        u32 const new_max_buffers = buffer_slots.next_max_resources(observed_max_buffers);
+        if (new_max_buffers <= observed_max_buffers)
+        {
+            return false;
+        }
+
+        VkBuffer new_buffer = {};
+        VmaAllocation new_allocation = {};
+        u64 * new_host_ptr = {};
+        auto result = this->create_buffer_device_address_buffer(new_max_buffers, new_buffer, new_allocation, new_host_ptr);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            if (new_buffer)
+            {
+                vmaDestroyBuffer(this->vma_allocator, new_buffer, new_allocation);
+            }
+            return false;
+        }
+
+        // Writers of the buffer device address buffer wait on the growth lock until the sequence is even again.
+        this->buffer_device_address_buffer_sequence.fetch_add(1, std::memory_order_seq_cst);
+        std::memcpy(new_host_ptr, this->buffer_device_address_buffer_host_ptr.load(std::memory_order_relaxed), observed_max_buffers * sizeof(u64));
+
+        VkBufferDeviceAddressInfo const new_buffer_address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = new_buffer,
+        };
+        result = this->gpu_sro_table.grow(this->vk_device, new_max_buffers, new_buffer, vkGetBufferDeviceAddress(this->vk_device, &new_buffer_address_info), zombie.table_storage);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            this->buffer_device_address_buffer_sequence.fetch_add(1, std::memory_order_release);
+            vmaUnmapMemory(this->vma_allocator, new_allocation);
+            vmaDestroyBuffer(this->vma_allocator, new_buffer, new_allocation);
+            return false;
+        }
+
+        vmaUnmapMemory(this->vma_allocator, this->buffer_device_address_buffer_allocation);
+        zombie.buffer_device_address_buffer = this->buffer_device_address_buffer;
+        zombie.buffer_device_address_buffer_allocation = this->buffer_device_address_buffer_allocation;
+        this->buffer_device_address_buffer = new_buffer;
+        this->buffer_device_address_buffer_allocation = new_allocation;
+        this->buffer_device_address_buffer_host_ptr.store(new_host_ptr, std::memory_order_relaxed);
+        this->buffer_device_address_buffer_sequence.fetch_add(1, std::memory_order_release);
+
+        // Publish the new capacity last, slots past the old capacity must only be handed out once the new storage is in place.
+        buffer_slots.max_resources.store(new_max_buffers, std::memory_order_release);
+    }
+
+    // Commands recorded before the growth still bind the old table storage, which points at the old buffer.
+    // Recorders that are still open hold back collection through their epoch, see recorder_epochs.
+    u64 const submit_timeline_value = this->global_submit_timeline.load(std::memory_order::relaxed);
+    this->resource_table_zombies.push(submit_timeline_value, zombie);
+    this->notify_garbage_collector();
+    return true;
+}
+
+void daxa_ImplDevice::write_buffer_device_address(u32 index, u64 address)
+{
+    while (true)
+    {
+        u64 const sequence = this->buffer_device_address_buffer_sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+        {
+            // A growth is copying the buffer, wait until it swapped in the new one.
+            std::unique_lock const lock{this->resource_table_growth_mtx};
+            continue;
+        }
+        this->buffer_device_address_buffer_host_ptr.load(std::memory_order_relaxed)[index] = address;
+        // Orders the write before the check. A growth that started copying in the meantime changed the sequence, the write is then repeated into the new buffer.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->buffer_device_address_buffer_sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            return;
+        }
+    }
+}
+
 auto daxa_ImplDevice::get_queue(daxa_Queue queue) -> daxa_ImplDevice::ImplQueue &
 {
     u32 offsets[3] = {
@@ -2264,7 +2973,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        auto & image_info = this->slot(id).info;
+        auto & image_info = this->cold_slot(id).info;
         return daxa_ImageMipArraySlice{
             .base_mip_level = 0,
             .level_count = image_info.mip_level_count,
@@ -2282,7 +2991,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        return this->slot(id).info.slice;
+        return this->cold_slot(id).info.slice;
     }
     else
     {
@@ -2294,9 +3003,9 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
 
-    auto slot_opt = this->gpu_sro_table.image_slots.try_create_slot();
+    auto slot_opt = this->gpu_sro_table.image_slots.try_create_slot_or_grow();
     DAXA_DBG_ASSERT_TRUE_M(slot_opt.has_value(), "CRITICAL INTERNAL ERROR, EXCEEDED MAX IMAGES IN SWAPCHAIN CREATION");
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -2306,7 +3015,8 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     };
 
     ret.vk_image = swapchain_image;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret.view_slot.image = std::bit_cast<daxa_ImageId>(id);
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(image_info.dimensions - 1),
         .format = image_info.format,
         .image = {id},
@@ -2343,7 +3053,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     };
     ret.swapchain_image_index = static_cast<i32>(index);
 
-    ret.info = *r_cast<daxa_ImageInfo const *>(&image_info);
+    ret_cold.info = *r_cast<daxa_ImageInfo const *>(&image_info);
     result = static_cast<daxa_Result>(vkCreateImageView(vk_device, &view_ci, nullptr, &ret.view_slot.vk_image_view));
     _DAXA_RETURN_IF_ERROR(result, result)
 
@@ -2369,11 +3079,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
         this->vkSetDebugUtilsObjectNameEXT(this->vk_device, &swapchain_image_view_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, ret.view_slot.vk_image_view, usage, id.index);
-    }
+    this->gpu_sro_table.queue_image_write(ret.view_slot.vk_image_view, usage, id.index);
 
     *out = ImageId{id};
 
@@ -2384,12 +3090,8 @@ void daxa_ImplDevice::cleanup_buffer(BufferId id)
 {
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplBufferSlot const & buffer_slot = this->gpu_sro_table.buffer_slots.unsafe_get(gid);
-    this->buffer_device_address_buffer_host_ptr[gid.index] = 0;
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_buffer(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_buffer, 0, VK_WHOLE_SIZE, gid.index);
-    }
+    this->write_buffer_device_address(gid.index, 0);
+    this->gpu_sro_table.queue_buffer_write(this->vk_null_buffer, this->vk_null_buffer_device_address, 0, NULL_BUFFER_SIZE, gid.index);
     if (buffer_slot.opt_memory_block != nullptr)
     {
         vkDestroyBuffer(this->vk_device, buffer_slot.vk_buffer, {});
@@ -2406,16 +3108,10 @@ void daxa_ImplDevice::cleanup_image(ImageId id)
     _DAXA_TEST_PRINT("cleanup image\n");
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplImageSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(gid);
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            this->vk_device,
-            this->gpu_sro_table.vk_descriptor_set,
-            this->vk_null_image_view,
-            std::bit_cast<ImageUsageFlags>(image_slot.info.usage),
-            gid.index);
-    }
+    this->gpu_sro_table.queue_image_write(
+        this->vk_null_image_view,
+        std::bit_cast<ImageUsageFlags>(gpu_sro_table.image_slots.unsafe_get_cold(gid).info.usage),
+        gid.index);
     vkDestroyImageView(vk_device, image_slot.view_slot.vk_image_view, nullptr);
     if (image_slot.swapchain_image_index == NOT_OWNED_BY_SWAPCHAIN)
     {
@@ -2435,11 +3131,7 @@ void daxa_ImplDevice::cleanup_image_view(ImageViewId id)
 {
     DAXA_DBG_ASSERT_TRUE_M(gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).vk_image == VK_NULL_HANDLE, "can not destroy default image view of image");
     ImplImageViewSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).view_slot;
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, std::bit_cast<daxa::ImageViewId>(id).index);
-    }
+    this->gpu_sro_table.queue_image_write(this->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, std::bit_cast<daxa::ImageViewId>(id).index);
     vkDestroyImageView(vk_device, image_slot.vk_image_view, nullptr);
     gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2447,11 +3139,7 @@ void daxa_ImplDevice::cleanup_image_view(ImageViewId id)
 void daxa_ImplDevice::cleanup_sampler(SamplerId id)
 {
     ImplSamplerSlot const & sampler_slot = this->gpu_sro_table.sampler_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_sampler, std::bit_cast<GPUResourceId>(id).index);
-    }
+    this->gpu_sro_table.queue_sampler_write(this->vk_null_sampler, std::bit_cast<GPUResourceId>(id).index);
     vkDestroySampler(this->vk_device, sampler_slot.vk_sampler, nullptr);
     gpu_sro_table.sampler_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2460,7 +3148,7 @@ void daxa_ImplDevice::cleanup_tlas(TlasId id)
 {
     ImplTlasSlot const & tlas_slot = this->gpu_sro_table.tlas_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
     // TODO(Raytracing): Add null acceleration structure:
-    // write_descriptor_set_acceleration_structure(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_acceleration_structure, std::bit_cast<GPUResourceId>(id).index);
+    // this->gpu_sro_table.queue_acceleration_structure_write(this->vk_null_acceleration_structure, this->vk_null_acceleration_structure_device_address, std::bit_cast<GPUResourceId>(id).index);
     this->vkDestroyAccelerationStructureKHR(this->vk_device, tlas_slot.vk_acceleration_structure, nullptr);
     gpu_sro_table.tlas_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2502,14 +3190,49 @@ auto daxa_ImplDevice::slot(daxa_BlasId id) const -> ImplBlasSlot const &
     return gpu_sro_table.blas_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id));
 }
 
+auto daxa_ImplDevice::cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &
+{
+    return gpu_sro_table.buffer_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id)).view_slot;
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &
+{
+    return gpu_sro_table.sampler_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &
+{
+    return gpu_sro_table.tlas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &
+{
+    return gpu_sro_table.blas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
 void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zero_ref_callback\n");
     auto self = rc_cast<daxa_Device>(handle);
+    self->stop_garbage_collector();
     auto result = daxa_dvc_wait_idle(self);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
     result = daxa_dvc_collect_garbage(self);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
+    for (auto & cache : self->thread_command_pool_caches)
+    {
+        cache->cleanup(self);
+    }
     for (auto & pool_pool : self->command_pool_pools)
     {
         pool_pool.cleanup(self);
@@ -2554,10 +3277,8 @@ void zombiefy(daxa_Device self, T id, auto & slots, auto & zombies)
         }
     }
     u64 const submit_timeline_value = self->global_submit_timeline.load(std::memory_order::relaxed);
-    {
-        std::unique_lock const lock{self->zombies_mtx};
-        zombies.push_front(std::pair{submit_timeline_value, id});
-    }
+    zombies.push(submit_timeline_value, id);
+    self->notify_garbage_collector();
 }
 
 void daxa_ImplDevice::zombify_buffer(BufferId id)
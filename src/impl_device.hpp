@@ -11,8 +11,14 @@
 
 #include <daxa/c/device.h>
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 using namespace daxa;
 
@@ -22,6 +28,115 @@ struct SubmitZombie
     std::vector<daxa_TimelineSemaphore> timeline_semaphores = {};
 };
 
+// Buffer device address buffer and table storage replaced by a growth of the buffer slots.
+// Kept alive until the gpu is done with submits that may read them.
+struct ResourceTableZombie
+{
+    VkBuffer buffer_device_address_buffer = {};
+    VmaAllocation buffer_device_address_buffer_allocation = {};
+    RetiredTableStorage table_storage = {};
+};
+
+// Multi producer, single consumer queue of zombies.
+// Destroying threads push into a buffer of their own shard, threads only share a shard beyond ShardedCounter::SHARD_COUNT threads.
+// The consumer (collect garbage) swaps the shard buffers with emptied ones and merges them into a deque sorted by timeline value, oldest first.
+// Buffers keep their capacity across swaps, so pushing does not allocate once the buffers have grown.
+template <typename ZombieT>
+struct ZombieQueue
+{
+    using Entry = std::pair<u64, ZombieT>;
+    struct alignas(64) Shard
+    {
+        std::mutex mtx = {};
+        std::vector<Entry> pushed = {};
+    };
+
+    std::array<Shard, ShardedCounter::SHARD_COUNT> shards = {};
+    // Only accessed by the consumer.
+    std::vector<Entry> swap_buffer = {};
+    std::deque<Entry> collected = {};
+    // Statistics, allow reading the depth without being the consumer.
+    ShardedCounter pushed_count = {};
+    std::atomic_uint64_t popped_count = {};
+
+    ZombieQueue() = default;
+    ZombieQueue(ZombieQueue const &) = delete;
+    auto operator=(ZombieQueue const &) -> ZombieQueue & = delete;
+
+    // Always threadsafe.
+    void push(u64 timeline_value, ZombieT zombie)
+    {
+        auto & shard = this->shards[ShardedCounter::thread_shard_index()];
+        {
+            std::unique_lock lock{shard.mtx};
+            shard.pushed.emplace_back(timeline_value, std::move(zombie));
+        }
+        this->pushed_count.add();
+    }
+
+    // Consumer only.
+    void pop_front()
+    {
+        this->collected.pop_front();
+        this->popped_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Consumer only.
+    // Moves all pushed zombies into collected, keeping it sorted by timeline value.
+    // Pushers can race between reading the timeline and pushing, so new zombies are not strictly ordered.
+    void merge()
+    {
+        auto const old_size = static_cast<std::ptrdiff_t>(this->collected.size());
+        for (auto & shard : this->shards)
+        {
+            {
+                std::unique_lock lock{shard.mtx};
+                if (shard.pushed.empty())
+                {
+                    continue;
+                }
+                std::swap(shard.pushed, this->swap_buffer);
+            }
+            std::move(this->swap_buffer.begin(), this->swap_buffer.end(), std::back_inserter(this->collected));
+            this->swap_buffer.clear();
+        }
+        auto const merged_begin = this->collected.begin() + old_size;
+        if (merged_begin == this->collected.end())
+        {
+            return;
+        }
+        auto const by_timeline_value = [](Entry const & a, Entry const & b)
+        {
+            return a.first < b.first;
+        };
+        // Zombies of a single thread usually arrive in order, sorting is only needed when several threads pushed.
+        if (!std::is_sorted(merged_begin, this->collected.end(), by_timeline_value))
+        {
+            std::sort(merged_begin, this->collected.end(), by_timeline_value);
+        }
+        if (old_size > 0 && by_timeline_value(*merged_begin, *std::prev(merged_begin)))
+        {
+            std::inplace_merge(this->collected.begin(), merged_begin, this->collected.end(), by_timeline_value);
+        }
+    }
+
+    // Consumer only.
+    auto size() -> usize
+    {
+        this->merge();
+        return this->collected.size();
+    }
+
+    // Always threadsafe.
+    // Approximate while zombies are pushed or destroyed concurrently.
+    auto pending_count() const -> u64
+    {
+        u64 const pushed = this->pushed_count.load();
+        u64 const popped = this->popped_count.load(std::memory_order_relaxed);
+        return pushed > popped ? pushed - popped : 0;
+    }
+};
+
 static inline constexpr u64 MAX_PENDING_SUBMISSIONS_PER_QUEUE = 64;
 static inline constexpr u64 MAIN_QUEUE_INDEX = 0;
 static inline constexpr u64 FIRST_COMPUTE_QUEUE_IDX = 1;
@@ -41,6 +156,9 @@ struct daxa_ImplDevice final : public ImplHandle
     // Dynamic State:
     PFN_vkCmdSetRasterizationSamplesEXT vkCmdSetRasterizationSamplesEXT = {};
 
+    // Multi draw:
+    PFN_vkCmdDrawMultiIndexedEXT vkCmdDrawMultiIndexedEXT = {};
+
     // Debug utils:
     PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT = {};
     PFN_vkCmdBeginDebugUtilsLabelEXT vkCmdBeginDebugUtilsLabelEXT = {};
@@ -64,8 +182,21 @@ struct daxa_ImplDevice final : public ImplHandle
     PFN_vkCmdTraceRaysKHR vkCmdTraceRaysKHR = {};
     PFN_vkCmdTraceRaysIndirectKHR vkCmdTraceRaysIndirectKHR = {};
 
+    // Descriptor buffer:
+    PFN_vkGetDescriptorSetLayoutSizeEXT vkGetDescriptorSetLayoutSizeEXT = {};
+    PFN_vkGetDescriptorSetLayoutBindingOffsetEXT vkGetDescriptorSetLayoutBindingOffsetEXT = {};
+    PFN_vkGetDescriptorEXT vkGetDescriptorEXT = {};
+    PFN_vkCmdBindDescriptorBuffersEXT vkCmdBindDescriptorBuffersEXT = {};
+    PFN_vkCmdSetDescriptorBufferOffsetsEXT vkCmdSetDescriptorBufferOffsetsEXT = {};
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptor_buffer_properties = {};
+
+    // Serializes growth of the buffer slots, see try_grow_buffer_slots.
+    std::mutex resource_table_growth_mtx = {};
+    // The buffer is replaced when the buffer slots grow.
+    // The sequence is odd while a growth copies the buffer, see write_buffer_device_address.
+    std::atomic_uint64_t buffer_device_address_buffer_sequence = {};
     VkBuffer buffer_device_address_buffer = {};
-    u64 * buffer_device_address_buffer_host_ptr = {};
+    std::atomic<u64 *> buffer_device_address_buffer_host_ptr = {};
     VmaAllocation buffer_device_address_buffer_allocation = {};
 
     // 'Null' resources, used to fill empty slots in the resource table after a resource is destroyed.
@@ -73,7 +204,9 @@ struct daxa_ImplDevice final : public ImplHandle
     // BUT, accessing garbage descriptors normally causes a device lost immediately, making debugging much harder.
     // So instead of leaving dead descriptors dangle, daxa overwrites them with 'null' descriptors that just contain some debug value (pink 0xFF00FFFF).
     // This in particular prevents device hang in the case of a use after free if the device does not encounter a race condition on the descriptor update before.
+    static inline constexpr VkDeviceSize NULL_BUFFER_SIZE = sizeof(u8) * 4;
     VkBuffer vk_null_buffer = {};
+    VkDeviceAddress vk_null_buffer_device_address = {};
     VkImage vk_null_image = {};
     VkImageView vk_null_image_view = {};
     VkSampler vk_null_sampler = {};
@@ -83,6 +216,15 @@ struct daxa_ImplDevice final : public ImplHandle
     // Command Buffer/Pool recycling:
     // Index with daxa_QueueFamily.
     std::array<CommandPoolPool, 3> command_pool_pools = {};
+    // Each thread retires the pools of its dead recorders into its own cache and takes new ones from there.
+    // Recorder creation and destruction thereby avoid the locked pool pools and the garbage collector in steady state.
+    // The caches are owned by the device, threads find theirs via a thread local lookup by device serial.
+    // The thread locals only hold weak references, so they notice when the device is gone.
+    u64 serial = {};
+    std::mutex thread_command_pool_caches_mtx = {};
+    std::vector<std::shared_ptr<ThreadCommandPoolCache>> thread_command_pool_caches = {};
+    // Keeps zombies alive that alive command recorders may reference.
+    RecorderEpochs recorder_epochs = {};
 
     // Gpu Shader Resource Object table:
     GPUShaderResourceTable gpu_sro_table = {};
@@ -93,19 +235,38 @@ struct daxa_ImplDevice final : public ImplHandle
     // When collect garbage is called, the zombies timeline values are compared against submits running in all queues.
     // If the zombies global submit index is smaller then global index of all submits currently in flight (on all queues), we can safely clean the resource up.
     std::atomic_uint64_t global_submit_timeline = {};
-    std::recursive_mutex zombies_mtx = {};
-    std::deque<std::pair<u64, CommandRecorderZombie>> command_list_zombies = {};
-    std::deque<std::pair<u64, BufferId>> buffer_zombies = {};
-    std::deque<std::pair<u64, ImageId>> image_zombies = {};
-    std::deque<std::pair<u64, ImageViewId>> image_view_zombies = {};
-    std::deque<std::pair<u64, SamplerId>> sampler_zombies = {};
-    std::deque<std::pair<u64, TlasId>> tlas_zombies = {};
-    std::deque<std::pair<u64, BlasId>> blas_zombies = {};
-    std::deque<std::pair<u64, SemaphoreZombie>> semaphore_zombies = {};
-    std::deque<std::pair<u64, EventZombie>> split_barrier_zombies = {};
-    std::deque<std::pair<u64, PipelineZombie>> pipeline_zombies = {};
-    std::deque<std::pair<u64, TimelineQueryPoolZombie>> timeline_query_pool_zombies = {};
-    std::deque<std::pair<u64, MemoryBlockZombie>> memory_block_zombies = {};
+    // All submits up to this global timeline value are known to be finished, updated by collect garbage.
+    std::atomic_uint64_t finished_submit_timeline_value = {};
+    // Zombies are pushed locklessly, the mutex only serializes consumers.
+    std::mutex zombies_mtx = {};
+    ZombieQueue<CommandRecorderZombie> command_list_zombies = {};
+    ZombieQueue<BufferId> buffer_zombies = {};
+    ZombieQueue<ImageId> image_zombies = {};
+    ZombieQueue<ImageViewId> image_view_zombies = {};
+    ZombieQueue<SamplerId> sampler_zombies = {};
+    ZombieQueue<TlasId> tlas_zombies = {};
+    ZombieQueue<BlasId> blas_zombies = {};
+    ZombieQueue<SemaphoreZombie> semaphore_zombies = {};
+    ZombieQueue<EventZombie> split_barrier_zombies = {};
+    ZombieQueue<PipelineZombie> pipeline_zombies = {};
+    ZombieQueue<TimelineQueryPoolZombie> timeline_query_pool_zombies = {};
+    ZombieQueue<MemoryBlockZombie> memory_block_zombies = {};
+    ZombieQueue<ResourceTableZombie> resource_table_zombies = {};
+
+    // Optional background garbage collection:
+    // The thread sleeps until any queue retires a submit, then destroys all zombies that became free.
+    // Without pending submits it sleeps on the condition variable until new zombies, submits or a retired recorder wake it up.
+    // It never waits for command recorders, zombies they may reference are simply left for a later wakeup.
+    // The semaphore wait times out only so that the thread notices when it is stopped.
+    static inline constexpr u64 GARBAGE_COLLECTOR_WAIT_TIMEOUT_NANOS = 10'000'000;
+    std::thread garbage_collector_thread = {};
+    std::mutex garbage_collector_mtx = {};
+    std::condition_variable garbage_collector_cv = {};
+    bool garbage_collector_stop = {};
+    std::atomic_bool garbage_collector_work_pending = {};
+    // The thread exits on the first fatal error (for example a lost device) and stores it here.
+    // It is returned by all following submits, presents, garbage collections and idle waits.
+    std::atomic<daxa_Result> garbage_collector_error = DAXA_RESULT_SUCCESS;
 
     // Queues
     struct ImplQueue
@@ -118,6 +279,11 @@ struct daxa_ImplDevice final : public ImplHandle
         VkSemaphore gpu_queue_local_timeline = {};
         // atomically synchronized:
         std::atomic_uint64_t latest_pending_submit_timeline_value = {};
+        // Submits that took a global timeline value but did not store it in latest_pending_submit_timeline_value yet.
+        // Raised before taking the value, so the garbage collector never mistakes such a queue for idle.
+        std::atomic_uint32_t submits_in_flight = {};
+        // Statistics, submits to one queue are externally synchronized so this is never contended.
+        std::atomic_uint64_t submit_count = {};
 
         auto initialize(VkDevice vk_device) -> daxa_Result;
         void cleanup(VkDevice device);
@@ -152,6 +318,19 @@ struct daxa_ImplDevice final : public ImplHandle
 
     auto validate_image_slice(daxa_ImageMipArraySlice const & slice, daxa_ImageId id) -> daxa_ImageMipArraySlice;
     auto validate_image_slice(daxa_ImageMipArraySlice const & slice, daxa_ImageViewId id) -> daxa_ImageMipArraySlice;
+    void garbage_collector_loop();
+    void stop_garbage_collector();
+    // Threadsafe. Returns the error that stopped the background garbage collector, or success.
+    auto garbage_collector_result() const -> daxa_Result;
+    // Threadsafe. Wakes up the background garbage collector, if there is one.
+    void notify_garbage_collector();
+    // Returns nullptr on the garbage collector thread. It never creates recorders, so pools retired there would be stranded.
+    auto thread_command_pool_cache() -> ThreadCommandPoolCache *;
+    auto create_buffer_device_address_buffer(u32 buffer_count, VkBuffer & out_buffer, VmaAllocation & out_allocation, u64 *& out_host_ptr) -> daxa_Result;
+    // Grows the buffer slots together with the buffer device address buffer and the table storage, behaves like GpuResourcePool::try_grow.
+    auto try_grow_buffer_slots(u32 observed_max_buffers) -> bool;
+    // Lockless unless it races with a growth of the buffer slots.
+    void write_buffer_device_address(u32 index, u64 address);
     auto new_swapchain_image(VkImage swapchain_image, VkFormat format, u32 index, ImageUsageFlags usage, ImageInfo const & image_info, ImageId * out) -> daxa_Result;
 
     auto slot(daxa_BufferId id) const -> ImplBufferSlot const &;
@@ -161,6 +340,13 @@ struct daxa_ImplDevice final : public ImplHandle
     auto slot(daxa_TlasId id) const -> ImplTlasSlot const &;
     auto slot(daxa_BlasId id) const -> ImplBlasSlot const &;
 
+    auto cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &;
+    auto cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &;
+    auto cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &;
+    auto cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &;
+    auto cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &;
+    auto cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &;
+
     void cleanup_buffer(BufferId id);
     void cleanup_image(ImageId id);
     void cleanup_image_view(ImageViewId id);
@@ -179,6 +179,20 @@ namespace daxa
             chain = static_cast<void *>(&physical_device_pipeline_library_group_handles_ext);
         }
 
+        if (extensions.extensions_present[extensions.physical_device_descriptor_buffer_ext])
+        {
+            physical_device_descriptor_buffer_features_ext.pNext = chain;
+            physical_device_descriptor_buffer_features_ext.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+            chain = static_cast<void *>(&physical_device_descriptor_buffer_features_ext);
+        }
+
+        if (extensions.extensions_present[extensions.physical_device_multi_draw_ext])
+        {
+            physical_device_multi_draw_features_ext.pNext = chain;
+            physical_device_multi_draw_features_ext.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+            chain = static_cast<void *>(&physical_device_multi_draw_features_ext);
+        }
+
         physical_device_shader_demote_to_helper_invocation_features.pNext = chain;
         physical_device_shader_demote_to_helper_invocation_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_DEMOTE_TO_HELPER_INVOCATION_FEATURES;
         physical_device_shader_demote_to_helper_invocation_features.shaderDemoteToHelperInvocation = true;
@@ -224,6 +238,7 @@ namespace daxa
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind), DAXA_MISSING_REQUIRED_VK_FEATURE_DESCRIPTOR_BINDING_STORAGE_BUFFER_UPDATE_AFTER_BIND},
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending), DAXA_MISSING_REQUIRED_VK_FEATURE_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING},
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_indexing_features.descriptorBindingPartiallyBound), DAXA_MISSING_REQUIRED_VK_FEATURE_DESCRIPTOR_BINDING_PARTIALLY_BOUND},
+        RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_indexing_features.descriptorBindingVariableDescriptorCount), DAXA_MISSING_REQUIRED_VK_FEATURE_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT},
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_indexing_features.runtimeDescriptorArray), DAXA_MISSING_REQUIRED_VK_FEATURE_RUNTIME_DESCRIPTOR_ARRAY},
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_host_query_reset_features.hostQueryReset), DAXA_MISSING_REQUIRED_VK_FEATURE_HOST_QUERY_RESET},
         RequiredFeature{offsetof(PhysicalDeviceFeaturesStruct, physical_device_dynamic_rendering_features.dynamicRendering), DAXA_MISSING_REQUIRED_VK_FEATURE_DYNAMIC_RENDERING},
@@ -343,6 +358,14 @@ namespace daxa
         offsetof(PhysicalDeviceFeaturesStruct, physical_device_line_rasterization_features_khr.stippledSmoothLines),
     };
 
+    constexpr static std::array DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER_VK_FEATURES = std::array{
+        offsetof(PhysicalDeviceFeaturesStruct, physical_device_descriptor_buffer_features_ext.descriptorBuffer),
+    };
+
+    constexpr static std::array DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW_VK_FEATURES = std::array{
+        offsetof(PhysicalDeviceFeaturesStruct, physical_device_multi_draw_features_ext.multiDraw),
+    };
+
     constexpr static std::array IMPLICIT_FEATURES = std::array{
         ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_MESH_SHADER_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_MESH_SHADER},
         ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_BASIC_RAY_TRACING_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_BASIC_RAY_TRACING},
@@ -361,6 +384,8 @@ namespace daxa
         ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_SHADER_INT16_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_SHADER_INT16},
         ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_SHADER_CLOCK_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_SHADER_CLOCK},
         ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_LINE_RASTERIZATION_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_LINE_RASTERIZATION},
+        ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_DESCRIPTOR_BUFFER},
+        ImplicitFeature{DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW_VK_FEATURES, DAXA_IMPLICIT_FEATURE_FLAG_MULTI_DRAW},
     };
 
     // === Explicit Features ===
@@ -61,6 +61,8 @@ namespace daxa
             physical_device_shader_atomic_float_ext,
             physical_device_shader_clock_khr,
             physical_device_line_rasterization_khr,
+            physical_device_descriptor_buffer_ext,
+            physical_device_multi_draw_ext,
             // Used by DLSS
             physical_device_push_descriptor_khr,
             physical_device_binary_import_nvx,
@@ -86,6 +88,8 @@ namespace daxa
             VK_EXT_SHADER_ATOMIC_FLOAT_EXTENSION_NAME,
             VK_KHR_SHADER_CLOCK_EXTENSION_NAME,
             VK_KHR_LINE_RASTERIZATION_EXTENSION_NAME,
+            VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME,
+            VK_EXT_MULTI_DRAW_EXTENSION_NAME,
             // Used by DLSS
             VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
             VK_NVX_BINARY_IMPORT_EXTENSION_NAME,
@@ -129,6 +133,8 @@ namespace daxa
         VkPhysicalDeviceLineRasterizationFeaturesKHR physical_device_line_rasterization_features_khr = {};
         VkPhysicalDevicePipelineLibraryGroupHandlesFeaturesEXT physical_device_pipeline_library_group_handles_ext = {};
         VkPhysicalDeviceShaderDemoteToHelperInvocationFeatures physical_device_shader_demote_to_helper_invocation_features = {};
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT physical_device_descriptor_buffer_features_ext = {};
+        VkPhysicalDeviceMultiDrawFeaturesEXT physical_device_multi_draw_features_ext = {};
         VkPhysicalDeviceFeatures2 physical_device_features_2 = {};
         bool conservative_rasterization = {};
         bool swapchain = {};
@@ -1,7 +1,11 @@
 #include "impl_gpu_resources.hpp"
 
 #include <daxa/daxa.inl>
+#include <algorithm>
+#include <cstring>
 #include <format>
+#include <limits>
+#include <numeric>
 
 namespace daxa
 {
@@ -36,8 +40,10 @@ namespace daxa
     }
 
     auto GPUShaderResourceTable::initialize(u32 max_buffers, u32 max_images, u32 max_samplers, u32 max_acceleration_structures,
+                                            u32 max_growable_buffers, u32 max_growable_images, u32 max_growable_samplers,
                                             VkDevice device, VkBuffer device_address_buffer,
-                                            PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT) -> daxa_Result
+                                            PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT,
+                                            DescriptorBufferInitInfo const * opt_descriptor_buffer_info) -> daxa_Result
     {
         daxa_Result result = DAXA_RESULT_SUCCESS;
         defer
@@ -52,92 +58,40 @@ namespace daxa
                 {
                     vkDestroyDescriptorSetLayout(device, this->vk_descriptor_set_layout, nullptr);
                 }
+                if (this->descriptor_buffer.has_value() && this->descriptor_buffer->vk_buffer)
+                {
+                    if (this->descriptor_buffer->host_ptr)
+                    {
+                        vmaUnmapMemory(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vma_allocation);
+                    }
+                    vmaDestroyBuffer(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vk_buffer, this->descriptor_buffer->vma_allocation);
+                }
+                this->descriptor_buffer.reset();
             }
         };
 
+        this->vkSetDebugUtilsObjectNameEXT = vkSetDebugUtilsObjectNameEXT;
         bool const ray_tracing_enabled = max_acceleration_structures != (~0u);
 
         buffer_slots.max_resources = max_buffers;
         image_slots.max_resources = max_images;
         sampler_slots.max_resources = max_samplers;
+        // The layout is sized for the growth limits, so that pipeline layouts stay compatible when the table grows.
+        buffer_slots.max_growable_resources = std::max(max_growable_buffers, max_buffers);
+        image_slots.max_growable_resources = std::max(max_growable_images, max_images);
+        sampler_slots.max_growable_resources = std::max(max_growable_samplers, max_samplers);
         if (ray_tracing_enabled)
         {
             tlas_slots.max_resources = max_acceleration_structures;
+            tlas_slots.max_growable_resources = max_acceleration_structures;
             blas_slots.max_resources = 1'000'000; // TODO(Raytracing): Should we have a smarter limit?
+            blas_slots.max_growable_resources = 1'000'000;
         }
 
-        VkDescriptorPoolSize const buffer_descriptor_pool_size{
-            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = buffer_slots.max_resources + 1,
-        };
-
-        VkDescriptorPoolSize const storage_image_descriptor_pool_size{
-            .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .descriptorCount = image_slots.max_resources,
-        };
-
-        VkDescriptorPoolSize const sampled_image_descriptor_pool_size{
-            .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            .descriptorCount = image_slots.max_resources,
-        };
-
-        VkDescriptorPoolSize const sampler_descriptor_pool_size{
-            .type = VK_DESCRIPTOR_TYPE_SAMPLER,
-            .descriptorCount = sampler_slots.max_resources,
-        };
-
-        auto pool_sizes = std::vector{
-            buffer_descriptor_pool_size,
-            storage_image_descriptor_pool_size,
-            sampled_image_descriptor_pool_size,
-            sampler_descriptor_pool_size,
-        };
-        if (ray_tracing_enabled)
-        {
-            VkDescriptorPoolSize const as_descriptor_pool_size{
-                .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
-                .descriptorCount = tlas_slots.max_resources,
-            };
-            pool_sizes.push_back(as_descriptor_pool_size);
-        }
-
-        VkDescriptorPoolCreateInfo const vk_descriptor_pool_create_info{
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
-            .maxSets = 1,
-            .poolSizeCount = static_cast<u32>(pool_sizes.size()),
-            .pPoolSizes = pool_sizes.data(),
-        };
-
-        result = static_cast<daxa_Result>(vkCreateDescriptorPool(device, &vk_descriptor_pool_create_info, nullptr, &this->vk_descriptor_pool));
-        _DAXA_RETURN_IF_ERROR(result, result)
-
-        if (vkSetDebugUtilsObjectNameEXT != nullptr)
-        {
-            auto const * descriptor_pool_name = "mega descriptor pool";
-            VkDebugUtilsObjectNameInfoEXT const descriptor_pool_name_info{
-                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
-                .pNext = nullptr,
-                .objectType = VK_OBJECT_TYPE_DESCRIPTOR_POOL,
-                .objectHandle = std::bit_cast<uint64_t>(vk_descriptor_pool),
-                .pObjectName = descriptor_pool_name,
-            };
-            vkSetDebugUtilsObjectNameEXT(device, &descriptor_pool_name_info);
-        }
-
-        VkDescriptorSetLayoutBinding const buffer_descriptor_set_layout_binding{
-            .binding = DAXA_STORAGE_BUFFER_BINDING,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = static_cast<u32>(buffer_slots.max_resources),
-            .stageFlags = VK_SHADER_STAGE_ALL,
-            .pImmutableSamplers = nullptr,
-        };
-
         VkDescriptorSetLayoutBinding const storage_image_descriptor_set_layout_binding{
             .binding = DAXA_STORAGE_IMAGE_BINDING,
             .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .descriptorCount = static_cast<u32>(image_slots.max_resources),
+            .descriptorCount = static_cast<u32>(image_slots.max_growable_resources),
             .stageFlags = VK_SHADER_STAGE_ALL,
             .pImmutableSamplers = nullptr,
         };
@@ -145,7 +99,7 @@ namespace daxa
         VkDescriptorSetLayoutBinding const sampled_image_descriptor_set_layout_binding{
             .binding = DAXA_SAMPLED_IMAGE_BINDING,
             .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            .descriptorCount = static_cast<u32>(image_slots.max_resources),
+            .descriptorCount = static_cast<u32>(image_slots.max_growable_resources),
             .stageFlags = VK_SHADER_STAGE_ALL,
             .pImmutableSamplers = nullptr,
         };
@@ -153,7 +107,7 @@ namespace daxa
         VkDescriptorSetLayoutBinding const sampler_descriptor_set_layout_binding{
             .binding = DAXA_SAMPLER_BINDING,
             .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
-            .descriptorCount = static_cast<u32>(sampler_slots.max_resources),
+            .descriptorCount = static_cast<u32>(sampler_slots.max_growable_resources),
             .stageFlags = VK_SHADER_STAGE_ALL,
             .pImmutableSamplers = nullptr,
         };
@@ -167,7 +121,6 @@ namespace daxa
         };
 
         auto descriptor_set_layout_bindings = std::vector{
-            buffer_descriptor_set_layout_binding,
             storage_image_descriptor_set_layout_binding,
             sampled_image_descriptor_set_layout_binding,
             sampler_descriptor_set_layout_binding,
@@ -179,43 +132,84 @@ namespace daxa
             VkDescriptorSetLayoutBinding const as_descriptor_set_layout_binding{
                 .binding = DAXA_ACCELERATION_STRUCTURE_BINDING,
                 .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
-                .descriptorCount = static_cast<u32>(tlas_slots.max_resources),
+                .descriptorCount = static_cast<u32>(tlas_slots.max_growable_resources),
                 .stageFlags = VK_SHADER_STAGE_ALL,
                 .pImmutableSamplers = nullptr,
             };
             descriptor_set_layout_bindings.push_back(as_descriptor_set_layout_binding);
         }
 
-        auto vk_descriptor_binding_flags = std::vector{
-            VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
-            VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
-            VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
-            VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
-            VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT},
+        // Only the highest binding may have a variable descriptor count, so the storage buffers must come last.
+        // Set and descriptor buffer are allocated for the current buffer capacity, the layout declares the growth limit.
+        static_assert(DAXA_STORAGE_BUFFER_BINDING > DAXA_ACCELERATION_STRUCTURE_BINDING);
+        VkDescriptorSetLayoutBinding const buffer_descriptor_set_layout_binding{
+            .binding = DAXA_STORAGE_BUFFER_BINDING,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = static_cast<u32>(buffer_slots.max_growable_resources),
+            .stageFlags = VK_SHADER_STAGE_ALL,
+            .pImmutableSamplers = nullptr,
         };
-        if (ray_tracing_enabled)
+        descriptor_set_layout_bindings.push_back(buffer_descriptor_set_layout_binding);
+
+        bool use_descriptor_buffer = opt_descriptor_buffer_info != nullptr;
+
+        auto create_descriptor_set_layout = [&]() -> daxa_Result
         {
-            vk_descriptor_binding_flags.push_back({VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT});
-        }
+            // Descriptor buffers do not support update after bind.
+            // They do not need it either, writing a descriptor buffer never invalidates recorded commands.
+            VkDescriptorBindingFlags const binding_flags =
+                use_descriptor_buffer
+                    ? VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT}
+                    : VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT};
+            auto vk_descriptor_binding_flags = std::vector<VkDescriptorBindingFlags>(descriptor_set_layout_bindings.size(), binding_flags);
+            vk_descriptor_binding_flags.back() |= VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
 
-        VkDescriptorSetLayoutBindingFlagsCreateInfo vk_descriptor_set_layout_binding_flags_create_info{
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
-            .pNext = nullptr,
-            .bindingCount = static_cast<u32>(vk_descriptor_binding_flags.size()),
-            .pBindingFlags = vk_descriptor_binding_flags.data(),
-        };
+            VkDescriptorSetLayoutBindingFlagsCreateInfo vk_descriptor_set_layout_binding_flags_create_info{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+                .pNext = nullptr,
+                .bindingCount = static_cast<u32>(vk_descriptor_binding_flags.size()),
+                .pBindingFlags = vk_descriptor_binding_flags.data(),
+            };
+
+            VkDescriptorSetLayoutCreateInfo const vk_descriptor_set_layout_create_info{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .pNext = &vk_descriptor_set_layout_binding_flags_create_info,
+                .flags = use_descriptor_buffer
+                             ? VkDescriptorSetLayoutCreateFlags{VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT}
+                             : VkDescriptorSetLayoutCreateFlags{VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT},
+                .bindingCount = static_cast<u32>(descriptor_set_layout_bindings.size()),
+                .pBindings = descriptor_set_layout_bindings.data(),
+            };
 
-        VkDescriptorSetLayoutCreateInfo const vk_descriptor_set_layout_create_info{
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-            .pNext = &vk_descriptor_set_layout_binding_flags_create_info,
-            .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
-            .bindingCount = static_cast<u32>(descriptor_set_layout_bindings.size()),
-            .pBindings = descriptor_set_layout_bindings.data(),
+            return static_cast<daxa_Result>(vkCreateDescriptorSetLayout(device, &vk_descriptor_set_layout_create_info, nullptr, &this->vk_descriptor_set_layout));
         };
 
-        result = static_cast<daxa_Result>(vkCreateDescriptorSetLayout(device, &vk_descriptor_set_layout_create_info, nullptr, &this->vk_descriptor_set_layout));
+        result = create_descriptor_set_layout();
         _DAXA_RETURN_IF_ERROR(result, result)
 
+        if (use_descriptor_buffer)
+        {
+            auto const & properties = *opt_descriptor_buffer_info->properties;
+            // Size of the layout with the growth limit, the buffer must fit it once fully grown.
+            VkDeviceSize max_descriptor_buffer_size = {};
+            opt_descriptor_buffer_info->vkGetDescriptorSetLayoutSizeEXT(device, this->vk_descriptor_set_layout, &max_descriptor_buffer_size);
+            // Samplers and resources share the one descriptor buffer, so it must fit the limits of both.
+            bool const fits_descriptor_buffer_limits =
+                properties.maxDescriptorBufferBindings >= 1 &&
+                max_descriptor_buffer_size <= properties.maxResourceDescriptorBufferRange &&
+                max_descriptor_buffer_size <= properties.maxSamplerDescriptorBufferRange &&
+                max_descriptor_buffer_size <= properties.resourceDescriptorBufferAddressSpaceSize &&
+                max_descriptor_buffer_size <= properties.samplerDescriptorBufferAddressSpaceSize;
+            if (!fits_descriptor_buffer_limits)
+            {
+                vkDestroyDescriptorSetLayout(device, this->vk_descriptor_set_layout, nullptr);
+                this->vk_descriptor_set_layout = {};
+                use_descriptor_buffer = false;
+                result = create_descriptor_set_layout();
+                _DAXA_RETURN_IF_ERROR(result, result)
+            }
+        }
+
         if (vkSetDebugUtilsObjectNameEXT != nullptr)
         {
             auto const * name = "mega descriptor set layout";
@@ -229,28 +223,44 @@ namespace daxa
             vkSetDebugUtilsObjectNameEXT(device, &name_info);
         }
 
-        VkDescriptorSetAllocateInfo const vk_descriptor_set_allocate_info{
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-            .pNext = nullptr,
-            .descriptorPool = this->vk_descriptor_pool,
-            .descriptorSetCount = 1,
-            .pSetLayouts = &this->vk_descriptor_set_layout,
-        };
+        if (use_descriptor_buffer)
+        {
+            auto const & properties = *opt_descriptor_buffer_info->properties;
+            this->descriptor_buffer = DescriptorBuffer{
+                .vma_allocator = opt_descriptor_buffer_info->vma_allocator,
+                .usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+                         VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                         VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                .queue_families = std::vector<u32>(opt_descriptor_buffer_info->queue_families, opt_descriptor_buffer_info->queue_families + opt_descriptor_buffer_info->queue_family_count),
+                .storage_buffer_descriptor_size = opt_descriptor_buffer_info->robust_buffer_access ? properties.robustStorageBufferDescriptorSize : properties.storageBufferDescriptorSize,
+                .storage_image_descriptor_size = properties.storageImageDescriptorSize,
+                .sampled_image_descriptor_size = properties.sampledImageDescriptorSize,
+                .sampler_descriptor_size = properties.samplerDescriptorSize,
+                .acceleration_structure_descriptor_size = properties.accelerationStructureDescriptorSize,
+                .vkGetDescriptorEXT = opt_descriptor_buffer_info->vkGetDescriptorEXT,
+                .vkCmdBindDescriptorBuffersEXT = opt_descriptor_buffer_info->vkCmdBindDescriptorBuffersEXT,
+                .vkCmdSetDescriptorBufferOffsetsEXT = opt_descriptor_buffer_info->vkCmdSetDescriptorBufferOffsetsEXT,
+            };
+            auto & db = *this->descriptor_buffer;
 
-        result = static_cast<daxa_Result>(vkAllocateDescriptorSets(device, &vk_descriptor_set_allocate_info, &this->vk_descriptor_set));
-        _DAXA_RETURN_IF_ERROR(result, result)
+            for (auto const & binding : descriptor_set_layout_bindings)
+            {
+                opt_descriptor_buffer_info->vkGetDescriptorSetLayoutBindingOffsetEXT(device, this->vk_descriptor_set_layout, binding.binding, &db.binding_offsets.at(binding.binding));
+            }
 
-        if (vkSetDebugUtilsObjectNameEXT != nullptr)
+            VkDeviceAddress device_address = {};
+            result = this->create_descriptor_buffer(device, max_buffers, db, device_address);
+            _DAXA_RETURN_IF_ERROR(result, result)
+            this->descriptor_buffer_device_address.store(device_address, std::memory_order_relaxed);
+
+            this->vk_pipeline_create_flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        }
+        else
         {
-            auto const * name = "mega descriptor set";
-            VkDebugUtilsObjectNameInfoEXT const name_info{
-                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
-                .pNext = nullptr,
-                .objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET,
-                .objectHandle = std::bit_cast<uint64_t>(vk_descriptor_set),
-                .pObjectName = name,
-            };
-            vkSetDebugUtilsObjectNameEXT(device, &name_info);
+            VkDescriptorSet vk_descriptor_set = {};
+            result = this->create_descriptor_set(device, max_buffers, this->vk_descriptor_pool, vk_descriptor_set);
+            _DAXA_RETURN_IF_ERROR(result, result)
+            this->vk_descriptor_set.store(vk_descriptor_set, std::memory_order_relaxed);
         }
 
         auto vk_descriptor_set_layouts = std::array{this->vk_descriptor_set_layout};
@@ -306,6 +316,286 @@ namespace daxa
             }
         }
 
+        VkBufferDeviceAddressInfo const device_address_buffer_address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = device_address_buffer,
+        };
+        {
+            std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+            this->write_buffer_device_address_buffer(device, device_address_buffer, vkGetBufferDeviceAddress(device, &device_address_buffer_address_info), max_buffers);
+        }
+
+        return result;
+    }
+
+    auto GPUShaderResourceTable::create_descriptor_set(VkDevice device, u32 buffer_count, VkDescriptorPool & out_pool, VkDescriptorSet & out_set) -> daxa_Result
+    {
+        daxa_Result result = DAXA_RESULT_SUCCESS;
+        VkDescriptorPoolSize const buffer_descriptor_pool_size{
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            // One more for the buffer device address buffer.
+            .descriptorCount = buffer_count + 1,
+        };
+
+        VkDescriptorPoolSize const storage_image_descriptor_pool_size{
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .descriptorCount = image_slots.max_growable_resources,
+        };
+
+        VkDescriptorPoolSize const sampled_image_descriptor_pool_size{
+            .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .descriptorCount = image_slots.max_growable_resources,
+        };
+
+        VkDescriptorPoolSize const sampler_descriptor_pool_size{
+            .type = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .descriptorCount = sampler_slots.max_growable_resources,
+        };
+
+        auto pool_sizes = std::vector{
+            buffer_descriptor_pool_size,
+            storage_image_descriptor_pool_size,
+            sampled_image_descriptor_pool_size,
+            sampler_descriptor_pool_size,
+        };
+        if (tlas_slots.max_growable_resources != 0)
+        {
+            VkDescriptorPoolSize const as_descriptor_pool_size{
+                .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+                .descriptorCount = tlas_slots.max_growable_resources,
+            };
+            pool_sizes.push_back(as_descriptor_pool_size);
+        }
+
+        VkDescriptorPoolCreateInfo const vk_descriptor_pool_create_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            .maxSets = 1,
+            .poolSizeCount = static_cast<u32>(pool_sizes.size()),
+            .pPoolSizes = pool_sizes.data(),
+        };
+
+        VkDescriptorPool vk_descriptor_pool = {};
+        result = static_cast<daxa_Result>(vkCreateDescriptorPool(device, &vk_descriptor_pool_create_info, nullptr, &vk_descriptor_pool));
+        _DAXA_RETURN_IF_ERROR(result, result)
+
+        if (this->vkSetDebugUtilsObjectNameEXT != nullptr)
+        {
+            auto const * descriptor_pool_name = "mega descriptor pool";
+            VkDebugUtilsObjectNameInfoEXT const descriptor_pool_name_info{
+                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+                .pNext = nullptr,
+                .objectType = VK_OBJECT_TYPE_DESCRIPTOR_POOL,
+                .objectHandle = std::bit_cast<uint64_t>(vk_descriptor_pool),
+                .pObjectName = descriptor_pool_name,
+            };
+            this->vkSetDebugUtilsObjectNameEXT(device, &descriptor_pool_name_info);
+        }
+
+        VkDescriptorSetVariableDescriptorCountAllocateInfo const vk_variable_descriptor_count_allocate_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+            .pNext = nullptr,
+            .descriptorSetCount = 1,
+            .pDescriptorCounts = &buffer_count,
+        };
+
+        VkDescriptorSetAllocateInfo const vk_descriptor_set_allocate_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .pNext = &vk_variable_descriptor_count_allocate_info,
+            .descriptorPool = vk_descriptor_pool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &this->vk_descriptor_set_layout,
+        };
+
+        VkDescriptorSet vk_descriptor_set = {};
+        result = static_cast<daxa_Result>(vkAllocateDescriptorSets(device, &vk_descriptor_set_allocate_info, &vk_descriptor_set));
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            vkDestroyDescriptorPool(device, vk_descriptor_pool, nullptr);
+            return result;
+        }
+
+        if (this->vkSetDebugUtilsObjectNameEXT != nullptr)
+        {
+            auto const * name = "mega descriptor set";
+            VkDebugUtilsObjectNameInfoEXT const name_info{
+                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+                .pNext = nullptr,
+                .objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET,
+                .objectHandle = std::bit_cast<uint64_t>(vk_descriptor_set),
+                .pObjectName = name,
+            };
+            this->vkSetDebugUtilsObjectNameEXT(device, &name_info);
+        }
+
+        out_pool = vk_descriptor_pool;
+        out_set = vk_descriptor_set;
+        return result;
+    }
+
+    auto GPUShaderResourceTable::create_descriptor_buffer(VkDevice device, u32 buffer_count, DescriptorBuffer & db, VkDeviceAddress & out_device_address) -> daxa_Result
+    {
+        daxa_Result result = DAXA_RESULT_SUCCESS;
+        // The variable count binding always is placed after all other bindings.
+        VkDeviceSize const size = db.binding_offsets.at(DAXA_STORAGE_BUFFER_BINDING) + static_cast<VkDeviceSize>(buffer_count) * db.storage_buffer_descriptor_size;
+
+        VkBufferCreateInfo const descriptor_buffer_create_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .size = size,
+            .usage = db.usage,
+            .sharingMode = VK_SHARING_MODE_CONCURRENT,
+            .queueFamilyIndexCount = static_cast<u32>(db.queue_families.size()),
+            .pQueueFamilyIndices = db.queue_families.data(),
+        };
+
+        VmaAllocationCreateInfo const descriptor_buffer_allocation_create_info{
+            .flags = static_cast<VmaAllocationCreateFlags>(VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT),
+            .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+            .requiredFlags = {},
+            .preferredFlags = {},
+            .memoryTypeBits = std::numeric_limits<u32>::max(),
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 1.0f,
+        };
+
+        VkBuffer vk_buffer = {};
+        VmaAllocation vma_allocation = {};
+        std::byte * host_ptr = {};
+        result = static_cast<daxa_Result>(vmaCreateBuffer(db.vma_allocator, &descriptor_buffer_create_info, &descriptor_buffer_allocation_create_info, &vk_buffer, &vma_allocation, nullptr));
+        _DAXA_RETURN_IF_ERROR(result, result)
+        result = static_cast<daxa_Result>(vmaMapMemory(db.vma_allocator, vma_allocation, r_cast<void **>(&host_ptr)));
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            vmaDestroyBuffer(db.vma_allocator, vk_buffer, vma_allocation);
+            return result;
+        }
+
+        if (this->vkSetDebugUtilsObjectNameEXT != nullptr)
+        {
+            auto const * name = "mega descriptor buffer";
+            VkDebugUtilsObjectNameInfoEXT const name_info{
+                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+                .pNext = nullptr,
+                .objectType = VK_OBJECT_TYPE_BUFFER,
+                .objectHandle = std::bit_cast<uint64_t>(vk_buffer),
+                .pObjectName = name,
+            };
+            this->vkSetDebugUtilsObjectNameEXT(device, &name_info);
+        }
+
+        VkBufferDeviceAddressInfo const descriptor_buffer_address_info{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = vk_buffer,
+        };
+        out_device_address = vkGetBufferDeviceAddress(device, &descriptor_buffer_address_info);
+        db.vk_buffer = vk_buffer;
+        db.vma_allocation = vma_allocation;
+        db.host_ptr = host_ptr;
+        db.size = size;
+        return result;
+    }
+
+    auto GPUShaderResourceTable::grow(VkDevice device, u32 buffer_count, VkBuffer device_address_buffer, VkDeviceAddress device_address_buffer_address, RetiredTableStorage & out_retired) -> daxa_Result
+    {
+        daxa_Result result = DAXA_RESULT_SUCCESS;
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        // Queued writes must land in the old storage as well, commands recorded before the growth keep reading it.
+        this->flush_descriptor_writes_locked(device);
+
+        if (this->descriptor_buffer.has_value())
+        {
+            DescriptorBuffer new_descriptor_buffer = *this->descriptor_buffer;
+            VkDeviceAddress new_device_address = {};
+            result = this->create_descriptor_buffer(device, buffer_count, new_descriptor_buffer, new_device_address);
+            _DAXA_RETURN_IF_ERROR(result, result)
+            // The storage buffers are the last binding, so the old buffer is a prefix of the new one.
+            std::memcpy(new_descriptor_buffer.host_ptr, this->descriptor_buffer->host_ptr, this->descriptor_buffer->size);
+            vmaUnmapMemory(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vma_allocation);
+            out_retired.descriptor_buffer = this->descriptor_buffer->vk_buffer;
+            out_retired.descriptor_buffer_allocation = this->descriptor_buffer->vma_allocation;
+            *this->descriptor_buffer = std::move(new_descriptor_buffer);
+            this->write_buffer_device_address_buffer(device, device_address_buffer, device_address_buffer_address, buffer_count);
+            // No-op for host coherent memory.
+            vmaFlushAllocation(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vma_allocation, 0, VK_WHOLE_SIZE);
+            this->descriptor_buffer_device_address.store(new_device_address, std::memory_order_relaxed);
+        }
+        else
+        {
+            VkDescriptorPool new_vk_descriptor_pool = {};
+            VkDescriptorSet new_vk_descriptor_set = {};
+            result = this->create_descriptor_set(device, buffer_count, new_vk_descriptor_pool, new_vk_descriptor_set);
+            _DAXA_RETURN_IF_ERROR(result, result)
+
+            VkDescriptorSet const old_vk_descriptor_set = this->vk_descriptor_set.load(std::memory_order_relaxed);
+            std::array<VkCopyDescriptorSet, 5> copies = {};
+            u32 copy_count = {};
+            auto copy_binding = [&](u32 binding, u32 count)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+                copies.at(copy_count++) = VkCopyDescriptorSet{
+                    .sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET,
+                    .pNext = nullptr,
+                    .srcSet = old_vk_descriptor_set,
+                    .srcBinding = binding,
+                    .srcArrayElement = 0,
+                    .dstSet = new_vk_descriptor_set,
+                    .dstBinding = binding,
+                    .dstArrayElement = 0,
+                    .descriptorCount = count,
+                };
+            };
+            // Slots past next_index were never handed out, so their descriptors were never written.
+            copy_binding(DAXA_STORAGE_BUFFER_BINDING, this->buffer_slots.next_index.load(std::memory_order_relaxed));
+            copy_binding(DAXA_STORAGE_IMAGE_BINDING, this->image_slots.next_index.load(std::memory_order_relaxed));
+            copy_binding(DAXA_SAMPLED_IMAGE_BINDING, this->image_slots.next_index.load(std::memory_order_relaxed));
+            copy_binding(DAXA_SAMPLER_BINDING, this->sampler_slots.next_index.load(std::memory_order_relaxed));
+            copy_binding(DAXA_ACCELERATION_STRUCTURE_BINDING, this->tlas_slots.next_index.load(std::memory_order_relaxed));
+            vkUpdateDescriptorSets(device, 0, nullptr, copy_count, copies.data());
+
+            out_retired.vk_descriptor_pool = this->vk_descriptor_pool;
+            this->vk_descriptor_pool = new_vk_descriptor_pool;
+            this->vk_descriptor_set.store(new_vk_descriptor_set, std::memory_order_relaxed);
+            this->write_buffer_device_address_buffer(device, device_address_buffer, device_address_buffer_address, buffer_count);
+        }
+
+        this->generation.fetch_add(1, std::memory_order_release);
+        return result;
+    }
+
+    void GPUShaderResourceTable::write_buffer_device_address_buffer(VkDevice device, VkBuffer device_address_buffer, VkDeviceAddress device_address_buffer_address, u32 buffer_count)
+    {
+        if (this->descriptor_buffer.has_value())
+        {
+            auto const & db = *this->descriptor_buffer;
+            VkDescriptorAddressInfoEXT const address_info{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+                .pNext = nullptr,
+                .address = device_address_buffer_address,
+                .range = static_cast<VkDeviceSize>(buffer_count) * sizeof(u64),
+                .format = VK_FORMAT_UNDEFINED,
+            };
+            VkDescriptorGetInfoEXT const get_info{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+                .pNext = nullptr,
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .data = {.pStorageBuffer = &address_info},
+            };
+            VkDeviceSize const offset = db.binding_offsets.at(DAXA_BUFFER_DEVICE_ADDRESS_BUFFER_BINDING);
+            db.vkGetDescriptorEXT(device, &get_info, db.storage_buffer_descriptor_size, db.host_ptr + offset);
+            // No-op for host coherent memory.
+            vmaFlushAllocation(db.vma_allocator, db.vma_allocation, offset, db.storage_buffer_descriptor_size);
+            return;
+        }
+
         VkDescriptorBufferInfo const write_buffer{
             .buffer = device_address_buffer,
             .offset = 0,
@@ -315,7 +605,7 @@ namespace daxa
         VkWriteDescriptorSet const write{
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .pNext = nullptr,
-            .dstSet = this->vk_descriptor_set,
+            .dstSet = this->vk_descriptor_set.load(std::memory_order_relaxed),
             .dstBinding = DAXA_BUFFER_DEVICE_ADDRESS_BUFFER_BINDING,
             .dstArrayElement = 0,
             .descriptorCount = 1,
@@ -324,39 +614,38 @@ namespace daxa
             .pBufferInfo = &write_buffer,
             .pTexelBufferView = nullptr,
         };
-
         vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
-
-        return result;
     }
 
     void GPUShaderResourceTable::cleanup(VkDevice device)
     {
-        [[maybe_unused]] auto print_remaining = [&](std::string prefix, auto & pages)
+        [[maybe_unused]] auto print_remaining = [&](std::string prefix, auto & pool)
         {
             std::string ret{prefix + "\nthis can happen due to not waiting for the gpu to finish executing, as daxa defers destruction. List of survivors:\n"};
-            for (auto & page : pages)
+            for (usize page = 0; page < pool.pages.size(); ++page)
             {
-                if (page)
+                if (pool.pages[page])
                 {
-                    for (auto & slot : *page)
+                    for (usize offset = 0; offset < pool.PAGE_SIZE; ++offset)
                     {
+                        auto const & slot = pool.pages[page]->slots[offset];
+                        auto const & cold_slot = pool.cold_pages[page]->slots[offset];
                         bool handle_invalid = {};
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplBufferSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplBufferSlot>)
                         {
-                            handle_invalid = slot.first.vk_buffer == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_buffer == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplImageSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplImageSlot>)
                         {
-                            handle_invalid = slot.first.vk_image == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_image == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplSamplerSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplSamplerSlot>)
                         {
-                            handle_invalid = slot.first.vk_sampler == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_sampler == VK_NULL_HANDLE;
                         }
                         if (!handle_invalid)
                         {
-                            ret += std::format("debug name : \"{}\"", r_cast<SmallString const *>(&slot.first.info.name)->view());
+                            ret += std::format("debug name : \"{}\"", r_cast<SmallString const *>(&cold_slot.info.name)->view());
                             ret += "\n";
                         }
                     }
@@ -364,144 +653,394 @@ namespace daxa
             }
             return ret;
         };
-        DAXA_DBG_ASSERT_TRUE_MS(buffer_slots.free_index_stack.size() == buffer_slots.next_index, print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_MS(image_slots.free_index_stack.size() == image_slots.next_index, print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_MS(sampler_slots.free_index_stack.size() == sampler_slots.next_index, print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_MS(buffer_slots.free_index_count.load() == buffer_slots.next_index.load(), print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots));
+        DAXA_DBG_ASSERT_TRUE_MS(image_slots.free_index_count.load() == image_slots.next_index.load(), print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots));
+        DAXA_DBG_ASSERT_TRUE_MS(sampler_slots.free_index_count.load() == sampler_slots.next_index.load(), print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots));
         for (usize i = 0; i < DAXA_PIPELINE_LAYOUT_COUNT; ++i)
         {
             vkDestroyPipelineLayout(device, pipeline_layouts.at(i), nullptr);
         }
         vkDestroyDescriptorSetLayout(device, this->vk_descriptor_set_layout, nullptr);
-        vkResetDescriptorPool(device, this->vk_descriptor_pool, {});
-        vkDestroyDescriptorPool(device, this->vk_descriptor_pool, nullptr);
+        if (this->descriptor_buffer.has_value())
+        {
+            vmaUnmapMemory(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vma_allocation);
+            vmaDestroyBuffer(this->descriptor_buffer->vma_allocator, this->descriptor_buffer->vk_buffer, this->descriptor_buffer->vma_allocation);
+            this->descriptor_buffer.reset();
+        }
+        else
+        {
+            vkResetDescriptorPool(device, this->vk_descriptor_pool, {});
+            vkDestroyDescriptorPool(device, this->vk_descriptor_pool, nullptr);
+        }
     }
 
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index)
+    void GPUShaderResourceTable::bind_descriptor_buffer(VkCommandBuffer vk_cmd_buffer) const
     {
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = vk_sampler,
-            .imageView = VK_NULL_HANDLE,
-            .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set_storage{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        if (!this->descriptor_buffer.has_value())
+        {
+            return;
+        }
+        VkDescriptorBufferBindingInfoEXT const binding_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
             .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
+            .address = this->descriptor_buffer_device_address.load(std::memory_order_relaxed),
+            .usage = this->descriptor_buffer->usage,
         };
+        this->descriptor_buffer->vkCmdBindDescriptorBuffersEXT(vk_cmd_buffer, 1, &binding_info);
+    }
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set_storage, 0, nullptr);
+    void GPUShaderResourceTable::bind(VkCommandBuffer vk_cmd_buffer, VkPipelineBindPoint vk_bind_point, VkPipelineLayout vk_pipeline_layout) const
+    {
+        if (this->descriptor_buffer.has_value())
+        {
+            u32 const buffer_index = 0;
+            VkDeviceSize const offset = 0;
+            this->descriptor_buffer->vkCmdSetDescriptorBufferOffsetsEXT(vk_cmd_buffer, vk_bind_point, vk_pipeline_layout, 0, 1, &buffer_index, &offset);
+        }
+        else
+        {
+            VkDescriptorSet const vk_descriptor_set = this->vk_descriptor_set.load(std::memory_order_relaxed);
+            vkCmdBindDescriptorSets(vk_cmd_buffer, vk_bind_point, vk_pipeline_layout, 0, 1, &vk_descriptor_set, 0, nullptr);
+        }
+    }
+
+    void DescriptorWriteBatch::reserve(usize write_count)
+    {
+        this->writes.reserve(write_count);
+    }
+
+    void DescriptorWriteBatch::add_sampler(VkSampler vk_sampler, u32 index)
+    {
+        this->writes.push_back({
+            .binding = DAXA_SAMPLER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .info_index = static_cast<u32>(this->image_infos.size()),
+        });
+        this->image_infos.push_back({
+            .sampler = vk_sampler,
+            .imageView = VK_NULL_HANDLE,
+            .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        });
     }
 
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index)
+    void DescriptorWriteBatch::add_buffer(VkBuffer vk_buffer, VkDeviceAddress device_address, VkDeviceSize offset, VkDeviceSize range, u32 index)
     {
-        VkDescriptorBufferInfo const vk_descriptor_image_info{
+        this->writes.push_back({
+            .binding = DAXA_STORAGE_BUFFER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .info_index = static_cast<u32>(this->buffer_infos.size()),
+        });
+        this->buffer_infos.push_back({
             .buffer = vk_buffer,
             .offset = offset,
             .range = range,
-        };
+        });
+        this->buffer_device_addresses.push_back(device_address + offset);
+    }
 
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_BUFFER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo = nullptr,
-            .pBufferInfo = &vk_descriptor_image_info,
-            .pTexelBufferView = nullptr,
-        };
+    void DescriptorWriteBatch::add_image(VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    {
+        if ((usage & ImageUsageFlagBits::SHADER_STORAGE) != ImageUsageFlagBits::NONE)
+        {
+            this->writes.push_back({
+                .binding = DAXA_STORAGE_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .info_index = static_cast<u32>(this->image_infos.size()),
+            });
+            this->image_infos.push_back({
+                .sampler = VK_NULL_HANDLE,
+                .imageView = vk_image_view,
+                .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+            });
+        }
+        if ((usage & ImageUsageFlagBits::SHADER_SAMPLED) != ImageUsageFlagBits::NONE)
+        {
+            this->writes.push_back({
+                .binding = DAXA_SAMPLED_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                .info_index = static_cast<u32>(this->image_infos.size()),
+            });
+            this->image_infos.push_back({
+                .sampler = VK_NULL_HANDLE,
+                .imageView = vk_image_view,
+                .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+            });
+        }
+    }
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+    void DescriptorWriteBatch::add_acceleration_structure(VkAccelerationStructureKHR vk_acceleration_structure, VkDeviceAddress device_address, u32 index)
+    {
+        this->writes.push_back({
+            .binding = DAXA_ACCELERATION_STRUCTURE_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            .info_index = static_cast<u32>(this->acceleration_structures.size()),
+        });
+        this->acceleration_structures.push_back(vk_acceleration_structure);
+        this->acceleration_structure_device_addresses.push_back(device_address);
     }
 
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    auto DescriptorWriteBatch::empty() const -> bool
     {
-        u32 descriptor_set_write_count = 0;
-        std::array<VkWriteDescriptorSet, 2> descriptor_set_writes = {};
+        return this->writes.empty();
+    }
 
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
-        };
+    void DescriptorWriteBatch::append(DescriptorWriteBatch const & other)
+    {
+        u32 const buffer_info_offset = static_cast<u32>(this->buffer_infos.size());
+        u32 const image_info_offset = static_cast<u32>(this->image_infos.size());
+        u32 const acceleration_structure_offset = static_cast<u32>(this->acceleration_structures.size());
+        for (auto write : other.writes)
+        {
+            switch (write.type)
+            {
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: write.info_index += buffer_info_offset; break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: write.info_index += acceleration_structure_offset; break;
+            default: write.info_index += image_info_offset; break;
+            }
+            this->writes.push_back(write);
+        }
+        this->buffer_infos.insert(this->buffer_infos.end(), other.buffer_infos.begin(), other.buffer_infos.end());
+        this->image_infos.insert(this->image_infos.end(), other.image_infos.begin(), other.image_infos.end());
+        this->acceleration_structures.insert(this->acceleration_structures.end(), other.acceleration_structures.begin(), other.acceleration_structures.end());
+        this->buffer_device_addresses.insert(this->buffer_device_addresses.end(), other.buffer_device_addresses.begin(), other.buffer_device_addresses.end());
+        this->acceleration_structure_device_addresses.insert(this->acceleration_structure_device_addresses.end(), other.acceleration_structure_device_addresses.begin(), other.acceleration_structure_device_addresses.end());
+    }
 
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+    void DescriptorWriteBatch::clear()
+    {
+        this->writes.clear();
+        this->buffer_infos.clear();
+        this->image_infos.clear();
+        this->acceleration_structures.clear();
+        this->buffer_device_addresses.clear();
+        this->acceleration_structure_device_addresses.clear();
+    }
 
-        if ((usage & ImageUsageFlagBits::SHADER_STORAGE) != ImageUsageFlagBits::NONE)
+    void DescriptorWriteBatch::flush(VkDevice vk_device, VkDescriptorSet vk_descriptor_set)
+    {
+        if (this->writes.empty())
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set;
+            return;
         }
+        // Sort by binding and array element, so that writes to neighbouring elements end up next to each other.
+        // The sort is stable, so for multiple writes to the same descriptor the last queued one comes last.
+        this->sorted_write_indices.resize(this->writes.size());
+        std::iota(this->sorted_write_indices.begin(), this->sorted_write_indices.end(), 0u);
+        std::stable_sort(
+            this->sorted_write_indices.begin(), this->sorted_write_indices.end(),
+            [&](u32 a, u32 b)
+            {
+                return std::pair{this->writes[a].binding, this->writes[a].index} < std::pair{this->writes[b].binding, this->writes[b].index};
+            });
 
-        VkDescriptorImageInfo const vk_descriptor_image_info_sampled{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
-        };
+        // All of these are referenced by pointer from vk_writes, they must not reallocate while filling.
+        this->sorted_buffer_infos.clear();
+        this->sorted_buffer_infos.reserve(this->buffer_infos.size());
+        this->sorted_image_infos.clear();
+        this->sorted_image_infos.reserve(this->image_infos.size());
+        this->sorted_acceleration_structures.clear();
+        this->sorted_acceleration_structures.reserve(this->acceleration_structures.size());
+        this->vk_acceleration_structure_writes.clear();
+        this->vk_acceleration_structure_writes.reserve(this->acceleration_structures.size());
+        this->vk_writes.clear();
 
-        VkWriteDescriptorSet const vk_write_descriptor_set_sampled{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLED_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info_sampled,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+        for (usize i = 0; i < this->sorted_write_indices.size(); ++i)
+        {
+            auto const & write = this->writes[this->sorted_write_indices[i]];
+            // Only the last write to each descriptor is kept.
+            if (i + 1 < this->sorted_write_indices.size())
+            {
+                auto const & next_write = this->writes[this->sorted_write_indices[i + 1]];
+                if (next_write.binding == write.binding && next_write.index == write.index)
+                {
+                    continue;
+                }
+            }
+            // The infos of a run are pushed back to back, so a merged write can point to the first one.
+            bool const extends_previous =
+                !this->vk_writes.empty() &&
+                this->vk_writes.back().dstBinding == write.binding &&
+                this->vk_writes.back().dstArrayElement + this->vk_writes.back().descriptorCount == write.index;
+            if (extends_previous)
+            {
+                this->vk_writes.back().descriptorCount += 1;
+            }
+            else
+            {
+                this->vk_writes.push_back(VkWriteDescriptorSet{
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    .pNext = nullptr,
+                    .dstSet = vk_descriptor_set,
+                    .dstBinding = write.binding,
+                    .dstArrayElement = write.index,
+                    .descriptorCount = 1,
+                    .descriptorType = write.type,
+                    .pImageInfo = nullptr,
+                    .pBufferInfo = nullptr,
+                    .pTexelBufferView = nullptr,
+                });
+            }
+            auto & vk_write = this->vk_writes.back();
+            switch (write.type)
+            {
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                this->sorted_buffer_infos.push_back(this->buffer_infos[write.info_index]);
+                if (!extends_previous)
+                {
+                    vk_write.pBufferInfo = &this->sorted_buffer_infos.back();
+                }
+                break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                this->sorted_acceleration_structures.push_back(this->acceleration_structures[write.info_index]);
+                if (!extends_previous)
+                {
+                    this->vk_acceleration_structure_writes.push_back(VkWriteDescriptorSetAccelerationStructureKHR{
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
+                        .pNext = nullptr,
+                        .accelerationStructureCount = 0,
+                        .pAccelerationStructures = &this->sorted_acceleration_structures.back(),
+                    });
+                    vk_write.pNext = &this->vk_acceleration_structure_writes.back();
+                }
+                this->vk_acceleration_structure_writes.back().accelerationStructureCount += 1;
+                break;
+            default:
+                this->sorted_image_infos.push_back(this->image_infos[write.info_index]);
+                if (!extends_previous)
+                {
+                    vk_write.pImageInfo = &this->sorted_image_infos.back();
+                }
+                break;
+            }
+        }
 
-        if ((usage & ImageUsageFlagBits::SHADER_SAMPLED) != ImageUsageFlagBits::NONE)
+        vkUpdateDescriptorSets(vk_device, static_cast<u32>(this->vk_writes.size()), this->vk_writes.data(), 0, nullptr);
+        this->clear();
+    }
+
+    void DescriptorWriteBatch::flush(VkDevice vk_device, DescriptorBuffer const & descriptor_buffer)
+    {
+        if (this->writes.empty())
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set_sampled;
+            return;
         }
+        VkDeviceSize dirty_begin = std::numeric_limits<VkDeviceSize>::max();
+        VkDeviceSize dirty_end = 0;
+        for (auto const & write : this->writes)
+        {
+            VkDescriptorGetInfoEXT get_info{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+                .pNext = nullptr,
+                .type = write.type,
+                .data = {},
+            };
+            // Only used for storage buffers, must outlive the vkGetDescriptorEXT call.
+            VkDescriptorAddressInfoEXT address_info = {};
+            usize descriptor_size = {};
+            switch (write.type)
+            {
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                address_info = VkDescriptorAddressInfoEXT{
+                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+                    .pNext = nullptr,
+                    .address = this->buffer_device_addresses[write.info_index],
+                    .range = this->buffer_infos[write.info_index].range,
+                    .format = VK_FORMAT_UNDEFINED,
+                };
+                get_info.data.pStorageBuffer = &address_info;
+                descriptor_size = descriptor_buffer.storage_buffer_descriptor_size;
+                break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                get_info.data.pStorageImage = &this->image_infos[write.info_index];
+                descriptor_size = descriptor_buffer.storage_image_descriptor_size;
+                break;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                get_info.data.pSampledImage = &this->image_infos[write.info_index];
+                descriptor_size = descriptor_buffer.sampled_image_descriptor_size;
+                break;
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                get_info.data.pSampler = &this->image_infos[write.info_index].sampler;
+                descriptor_size = descriptor_buffer.sampler_descriptor_size;
+                break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                get_info.data.accelerationStructure = this->acceleration_structure_device_addresses[write.info_index];
+                descriptor_size = descriptor_buffer.acceleration_structure_descriptor_size;
+                break;
+            default: DAXA_DBG_ASSERT_TRUE_M(false, "unreachable"); break;
+            }
+            VkDeviceSize const offset = descriptor_buffer.binding_offsets.at(write.binding) + static_cast<VkDeviceSize>(write.index) * descriptor_size;
+            descriptor_buffer.vkGetDescriptorEXT(vk_device, &get_info, descriptor_size, descriptor_buffer.host_ptr + offset);
+            dirty_begin = std::min(dirty_begin, offset);
+            dirty_end = std::max(dirty_end, offset + descriptor_size);
+        }
+        // No-op for host coherent memory.
+        vmaFlushAllocation(descriptor_buffer.vma_allocator, descriptor_buffer.vma_allocation, dirty_begin, dirty_end - dirty_begin);
+        this->clear();
+    }
 
-        vkUpdateDescriptorSets(vk_device, descriptor_set_write_count, descriptor_set_writes.data(), 0, nullptr);
+    void GPUShaderResourceTable::queue_sampler_write(VkSampler vk_sampler, u32 index)
+    {
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        this->pending_descriptor_writes.add_sampler(vk_sampler, index);
+        this->descriptor_write_count.add();
     }
 
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index)
+    void GPUShaderResourceTable::queue_buffer_write(VkBuffer vk_buffer, VkDeviceAddress device_address, VkDeviceSize offset, VkDeviceSize range, u32 index)
     {
-        VkWriteDescriptorSetAccelerationStructureKHR vk_write_descriptor_set_as = {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
-            .pNext = nullptr,
-            .accelerationStructureCount = 1,
-            .pAccelerationStructures = &vk_acceleration_structure,
-        };
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        this->pending_descriptor_writes.add_buffer(vk_buffer, device_address, offset, range, index);
+        this->descriptor_write_count.add();
+    }
 
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = &vk_write_descriptor_set_as,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_ACCELERATION_STRUCTURE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
-            .pImageInfo = nullptr,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+    void GPUShaderResourceTable::queue_image_write(VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    {
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        this->pending_descriptor_writes.add_image(vk_image_view, usage, index);
+        this->descriptor_write_count.add();
+    }
+
+    void GPUShaderResourceTable::queue_acceleration_structure_write(VkAccelerationStructureKHR vk_acceleration_structure, VkDeviceAddress device_address, u32 index)
+    {
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        this->pending_descriptor_writes.add_acceleration_structure(vk_acceleration_structure, device_address, index);
+        this->descriptor_write_count.add();
+    }
+
+    void GPUShaderResourceTable::queue_writes(DescriptorWriteBatch & batch)
+    {
+        {
+            std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+            this->pending_descriptor_writes.append(batch);
+        }
+        this->descriptor_write_count.add(batch.writes.size());
+        batch.clear();
+    }
+
+    void GPUShaderResourceTable::flush_descriptor_writes(VkDevice device)
+    {
+        std::unique_lock const lock{this->pending_descriptor_writes_mtx};
+        this->flush_descriptor_writes_locked(device);
+    }
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+    void GPUShaderResourceTable::flush_descriptor_writes_locked(VkDevice device)
+    {
+        if (this->pending_descriptor_writes.empty())
+        {
+            return;
+        }
+        this->descriptor_write_flush_count.fetch_add(1, std::memory_order_relaxed);
+        if (this->descriptor_buffer.has_value())
+        {
+            this->pending_descriptor_writes.flush(device, *this->descriptor_buffer);
+        }
+        else
+        {
+            this->pending_descriptor_writes.flush(device, this->vk_descriptor_set.load(std::memory_order_relaxed));
+        }
     }
 } // namespace daxa
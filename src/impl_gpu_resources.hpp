@@ -6,32 +6,50 @@
 
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <span>
+#include <utility>
 
 namespace daxa
 {
+    // Slots are split into hot and cold data.
+    // Hot data holds everything needed to record commands (handles, addresses, sizes, flags).
+    // Cold data holds create infos and debug names, only read on creation, destruction and info queries.
+
     struct ImplBufferSlot
     {
-        daxa_BufferInfo info = {};
         VkBuffer vk_buffer = {};
         VmaAllocation vma_allocation = {};
         daxa_MemoryBlock opt_memory_block = {};
         VkDeviceAddress device_address = {};
         void * host_address = {};
+        // Copy of info.size, read by the bounds checks of buffer commands.
+        u64 size = {};
+    };
+
+    struct ImplBufferColdSlot
+    {
+        daxa_BufferInfo info = {};
     };
 
     static inline constexpr i32 NOT_OWNED_BY_SWAPCHAIN = -1;
 
     struct ImplImageViewSlot
     {
-        daxa_ImageViewInfo info = {};
         VkImageView vk_image_view = {};
+        // Copy of info.image, read by begin_renderpass to validate and track the attachment images.
+        daxa_ImageId image = {};
+    };
+
+    struct ImplImageViewColdSlot
+    {
+        daxa_ImageViewInfo info = {};
     };
 
     struct ImplImageSlot
     {
         ImplImageViewSlot view_slot = {};
-        daxa_ImageInfo info = {};
         VkImage vk_image = {};
         VmaAllocation vma_allocation = {};
         daxa_MemoryBlock opt_memory_block = {};
@@ -39,15 +57,24 @@ namespace daxa
         VkImageAspectFlags aspect_flags = {}; // Inferred from format.
     };
 
+    struct ImplImageColdSlot
+    {
+        ImplImageViewColdSlot view_slot = {};
+        daxa_ImageInfo info = {};
+    };
+
     struct ImplSamplerSlot
     {
-        daxa_SamplerInfo info = {};
         VkSampler vk_sampler = {};
     };
 
+    struct ImplSamplerColdSlot
+    {
+        daxa_SamplerInfo info = {};
+    };
+
     struct ImplTlasSlot
     {
-        daxa_TlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
@@ -56,9 +83,13 @@ namespace daxa
         bool owns_buffer = {};
     };
 
+    struct ImplTlasColdSlot
+    {
+        daxa_TlasInfo info = {};
+    };
+
     struct ImplBlasSlot
     {
-        daxa_BlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
@@ -67,6 +98,11 @@ namespace daxa
         bool owns_buffer = {};
     };
 
+    struct ImplBlasColdSlot
+    {
+        daxa_BlasInfo info = {};
+    };
+
     /**
      * @brief GpuResourcePool is intended to be used akin to a specialized memory allocator, specific to gpu resource types (like image views).
      *
@@ -78,7 +114,7 @@ namespace daxa
      * To check if these assumptions are met at runtime, the debug define DAXA_GPU_ID_VALIDATION can be enabled.
      * The define enables runtime checking to detect use after free and double free at the cost of performance.
      */
-    template <typename ResourceT>
+    template <typename ResourceT, typename ColdResourceT>
     struct GpuResourcePool
     {
         static constexpr inline usize MAX_RESOURCE_COUNT = 1u << 20u;
@@ -89,19 +125,176 @@ namespace daxa
         using VersionAndRefcntT = std::atomic_uint64_t;
         static constexpr inline u64 VERSION_ZOMBIE_BIT = 1ull << 63ull;
         static constexpr inline u64 VERSION_COUNT_MASK = ~(VERSION_ZOMBIE_BIT);
-        // TODO: split up slots into hot and cold data.
-        using PageT = std::array<std::pair<ResourceT, VersionAndRefcntT>, PAGE_SIZE>;
+        // Versions and hot slots are stored in separate dense arrays.
+        // Id validation only touches the versions, handle lookups only touch the hot slots.
+        struct PageT
+        {
+            std::array<VersionAndRefcntT, PAGE_SIZE> versions = {};
+            std::array<ResourceT, PAGE_SIZE> slots = {};
+        };
+        struct ColdPageT
+        {
+            std::array<ColdResourceT, PAGE_SIZE> slots = {};
+            // Per slot link of the free list. Only meaningful while the slot is in the free list.
+            std::array<std::atomic_uint32_t, PAGE_SIZE> free_links = {};
+        };
+        struct SlotRef
+        {
+            GPUResourceId id = {};
+            ResourceT & slot;
+            ColdResourceT & cold_slot;
+        };
 
-        // TODO: replace with lockless queue.
-        std::vector<u32> free_index_stack = {};
-        u32 next_index = {};
-        u32 max_resources = {};
+        // The free list head packs a 32 bit aba tag (upper bits) and the slot index + 1 (lower bits).
+        // A lower half of 0 means the free list is empty.
+        static constexpr inline u64 FREE_LIST_INDEX_MASK = 0xFFFF'FFFFull;
+        static constexpr inline u64 FREE_LIST_TAG_SHIFT = 32ull;
+        // Marks a reserved index that was turned into a slot, see create_reserved_slot.
+        static constexpr inline u32 CONSUMED_RESERVED_INDEX = ~0u;
+
+        // Lockless treiber stack of recycled slot indices.
+        std::atomic_uint64_t free_list_head = {};
+        // Number of indices currently in the free list, used to detect leaks on cleanup.
+        std::atomic_uint32_t free_index_count = {};
+        std::atomic_uint32_t next_index = {};
+        // Current capacity, raised at runtime up to max_growable_resources.
+        std::atomic_uint32_t max_resources = {};
+        u32 max_growable_resources = {};
+
+        // Statistics, see daxa_dvc_stats.
+        ShardedCounter created_count = {};
+        ShardedCounter destroyed_count = {};
+        // Slots that reached the max version, they are never recycled.
+        std::atomic_uint32_t retired_count = {};
 
-        mutable std::mutex mut = {};
         std::mutex page_alloc_mtx = {};
         std::array<std::unique_ptr<PageT>, PAGE_COUNT> pages = {};
+        std::array<std::unique_ptr<ColdPageT>, PAGE_COUNT> cold_pages = {};
         std::atomic_uint32_t valid_page_count = {};
 
+        auto free_link(u32 index) -> std::atomic_uint32_t &
+        {
+            return this->cold_pages[static_cast<usize>(index) >> PAGE_BITS]->free_links[static_cast<usize>(index) & PAGE_MASK];
+        }
+
+        void push_free_index(u32 index)
+        {
+            u64 head = this->free_list_head.load(std::memory_order_relaxed);
+            u64 new_head = {};
+            do
+            {
+                this->free_link(index).store(static_cast<u32>(head & FREE_LIST_INDEX_MASK), std::memory_order_relaxed);
+                u64 const tag = (head >> FREE_LIST_TAG_SHIFT) + 1;
+                new_head = (tag << FREE_LIST_TAG_SHIFT) | static_cast<u64>(index + 1);
+            } while (!this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+            this->free_index_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto try_pop_free_index() -> std::optional<u32>
+        {
+            u64 head = this->free_list_head.load(std::memory_order_acquire);
+            u64 new_head = {};
+            do
+            {
+                if ((head & FREE_LIST_INDEX_MASK) == 0)
+                {
+                    return std::nullopt;
+                }
+                // Links are never freed, so reading a link of a slot that was concurrently popped is fine.
+                // The aba tag makes the exchange fail in that case.
+                u32 const index = static_cast<u32>(head & FREE_LIST_INDEX_MASK) - 1;
+                u64 const next = this->free_link(index).load(std::memory_order_relaxed);
+                u64 const tag = (head >> FREE_LIST_TAG_SHIFT) + 1;
+                new_head = (tag << FREE_LIST_TAG_SHIFT) | next;
+            } while (!this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+            this->free_index_count.fetch_sub(1, std::memory_order_relaxed);
+            return static_cast<u32>(head & FREE_LIST_INDEX_MASK) - 1;
+        }
+
+        // Returns the first of count consecutive fresh indices.
+        auto try_alloc_fresh_indices(u32 count) -> std::optional<u32>
+        {
+            u32 index = this->next_index.load(std::memory_order_relaxed);
+            do
+            {
+                u64 const end = static_cast<u64>(index) + count;
+                if (end > this->max_resources.load(std::memory_order_acquire) || end > MAX_RESOURCE_COUNT)
+                {
+                    return std::nullopt;
+                }
+            } while (!this->next_index.compare_exchange_weak(index, index + count, std::memory_order_relaxed, std::memory_order_relaxed));
+            return index;
+        }
+
+        auto try_alloc_fresh_index() -> std::optional<u32>
+        {
+            return this->try_alloc_fresh_indices(1);
+        }
+
+        void ensure_page(usize page)
+        {
+            if (page < this->valid_page_count.load(std::memory_order_seq_cst))
+            {
+                return;
+            }
+            std::unique_lock l{page_alloc_mtx};
+            // Pages are allocated in order, the indices of a reservation can span several of them.
+            for (usize new_page = this->valid_page_count.load(std::memory_order_relaxed); new_page <= page; ++new_page)
+            {
+                this->pages[new_page] = std::make_unique<PageT>();
+                this->cold_pages[new_page] = std::make_unique<ColdPageT>();
+                for (u32 i = 0; i < PAGE_SIZE; ++i)
+                {
+                    this->pages[new_page]->versions[i].store(1ull, std::memory_order_relaxed);
+                }
+                // Needs to be sequential, so that the 0 writes to the versions are visible before the atomic op.
+                this->valid_page_count.fetch_add(1, std::memory_order_seq_cst);
+            }
+        }
+
+        auto create_slot_at(u32 index) -> SlotRef
+        {
+            auto const page = static_cast<usize>(index) >> PAGE_BITS;
+            auto const offset = static_cast<usize>(index) & PAGE_MASK;
+
+            this->ensure_page(page);
+
+            u64 version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
+            // Remove Zombie Mark Bit.
+            version = version & VERSION_COUNT_MASK;
+            this->pages[page]->versions[offset].store(version, std::memory_order_relaxed);
+
+            auto const id = GPUResourceId{.index = static_cast<u64>(index), .version = version};
+            this->created_count.add();
+            return SlotRef{id, this->pages[page]->slots[offset], this->cold_pages[page]->slots[offset]};
+        }
+
+        // Capacity the pool grows to once current_max_resources is exhausted.
+        // Returns current_max_resources when the pool can not grow any further.
+        auto next_max_resources(u32 current_max_resources) const -> u32
+        {
+            u32 const limit = std::max(std::min(this->max_growable_resources, static_cast<u32>(MAX_RESOURCE_COUNT)), current_max_resources);
+            return std::min(std::max(current_max_resources * 2, current_max_resources + static_cast<u32>(PAGE_SIZE)), limit);
+        }
+
+        /**
+         * @brief   Raises max_resources, if it still is observed_max_resources.
+         *          Slots never move, so all ids stay valid across growth.
+         *
+         * Always threadsafe.
+         * @returns false when the pool can not grow any further. True if this or a concurrent call grew the pool.
+         */
+        auto try_grow(u32 observed_max_resources) -> bool
+        {
+            u32 const new_max_resources = this->next_max_resources(observed_max_resources);
+            if (new_max_resources <= observed_max_resources)
+            {
+                return false;
+            }
+            this->max_resources.compare_exchange_strong(observed_max_resources, new_max_resources, std::memory_order_release, std::memory_order_relaxed);
+            return true;
+        }
+
         /**
          * @brief   Destroys a slot.
          *          After calling this function, the id of the slot will be forever invalid.
@@ -116,16 +309,21 @@ namespace daxa
             auto const page = static_cast<usize>(id.index) >> PAGE_BITS;
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
             // Remove Zombie Mark Bit.
-            auto const version = VERSION_COUNT_MASK & this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
+            auto const version = VERSION_COUNT_MASK & this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             // Slots that reached max version CAN NOT be recycled.
             // That is because we can not guarantee uniqueness of ids when the version wraps back to 0.
             // Clear slot MUST HAPPEN before pushing into free list.
-            this->pages[page]->at(offset).first = {};
+            this->pages[page]->slots[offset] = {};
+            this->cold_pages[page]->slots[offset] = {};
             if (version != DAXA_ID_VERSION_MASK /* this is the maximum value a version is allowed to reach */)
             {
-                std::unique_lock l{mut};
-                this->free_index_stack.push_back(id.index);
+                this->push_free_index(static_cast<u32>(id.index));
+            }
+            else
+            {
+                this->retired_count.fetch_add(1, std::memory_order_relaxed);
             }
+            this->destroyed_count.add();
         }
 
         /**
@@ -137,51 +335,147 @@ namespace daxa
          *
          * @return The new resource slot and its id. Can fail if max resources is exceeded.
          */
-        auto try_create_slot() -> std::optional<std::pair<GPUResourceId, ResourceT &>>
+        auto try_create_slot() -> std::optional<SlotRef>
         {
-            u32 index;
+            std::optional<u32> opt_index = this->try_pop_free_index();
+            if (!opt_index.has_value())
             {
-                std::unique_lock l{mut};
-                if (this->free_index_stack.empty())
+                opt_index = this->try_alloc_fresh_index();
+                if (!opt_index.has_value())
                 {
-                    index = this->next_index++;
-                    if (index >= this->max_resources || index >= MAX_RESOURCE_COUNT)
-                    {
-                        return std::nullopt;
-                    }
+                    return std::nullopt;
                 }
-                else
+            }
+            return std::optional<SlotRef>{this->create_slot_at(opt_index.value())};
+        }
+
+        /**
+         * @brief   Same as try_create_slot, but grows the pool when max_resources is exhausted.
+         *          grow_fn is called with the exhausted capacity and must behave like try_grow.
+         *          It allows to grow gpu side data indexed by the slots along with the pool.
+         *
+         * Always threadsafe.
+         * @return The new resource slot and its id. Can fail if the pool can not grow any further.
+         */
+        template <typename GrowFnT>
+        auto try_create_slot_or_grow(GrowFnT const & grow_fn) -> std::optional<SlotRef>
+        {
+            while (true)
+            {
+                u32 const observed_max_resources = this->max_resources.load(std::memory_order_acquire);
+                auto slot_opt = this->try_create_slot();
+                if (slot_opt.has_value() || !grow_fn(observed_max_resources))
                 {
-                    index = this->free_index_stack.back();
-                    this->free_index_stack.pop_back();
+                    return slot_opt;
                 }
             }
+        }
 
-            auto const page = static_cast<usize>(index) >> PAGE_BITS;
-            auto const offset = static_cast<usize>(index) & PAGE_MASK;
+        auto try_create_slot_or_grow() -> std::optional<SlotRef>
+        {
+            return this->try_create_slot_or_grow(
+                [this](u32 observed_max_resources)
+                {
+                    return this->try_grow(observed_max_resources);
+                });
+        }
 
-            if (page >= this->valid_page_count.load(std::memory_order_seq_cst))
+        /**
+         * @brief   Reserves out_indices.size() slot indices at once, for batched creation.
+         *          Recycled indices are popped one by one, all remaining ones are taken from next_index with a single CAS.
+         *          Every reserved index must either be passed to create_reserved_slot or to release_reserved_index.
+         *
+         * Always threadsafe.
+         * @return false if the pool can not hold that many more slots. Nothing is reserved in that case.
+         */
+        auto try_reserve_indices(std::span<u32> out_indices) -> bool
+        {
+            usize popped_count = 0;
+            for (; popped_count < out_indices.size(); ++popped_count)
             {
-                std::unique_lock l{page_alloc_mtx};
-                if (page >= this->valid_page_count.load(std::memory_order_relaxed))
+                std::optional<u32> const opt_index = this->try_pop_free_index();
+                if (!opt_index.has_value())
                 {
-                    this->pages[page] = std::make_unique<PageT>();
-                    for (u32 i = 0; i < PAGE_SIZE; ++i)
-                    {
-                        this->pages[page]->at(i).second.store(1ull, std::memory_order_relaxed);
-                    }
-                    // Needs to be sequential, so that the 0 writes to the versions are visible before the atomic op.
-                    this->valid_page_count.fetch_add(1, std::memory_order_seq_cst);
+                    break;
                 }
+                out_indices[popped_count] = opt_index.value();
             }
-            
-            u64 version = this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
-            // Remove Zombie Mark Bit.
-            version = version & VERSION_COUNT_MASK;
-            this->pages[page]->at(offset).second.store(version, std::memory_order_relaxed);
+            u32 const fresh_count = static_cast<u32>(out_indices.size() - popped_count);
+            if (fresh_count == 0)
+            {
+                return true;
+            }
+            std::optional<u32> const opt_first_fresh_index = this->try_alloc_fresh_indices(fresh_count);
+            if (!opt_first_fresh_index.has_value())
+            {
+                for (usize i = 0; i < popped_count; ++i)
+                {
+                    this->push_free_index(out_indices[i]);
+                }
+                return false;
+            }
+            for (u32 i = 0; i < fresh_count; ++i)
+            {
+                out_indices[popped_count + i] = opt_first_fresh_index.value() + i;
+            }
+            return true;
+        }
 
-            auto const id = GPUResourceId{.index = static_cast<u64>(index), .version = version};
-            return std::optional{std::pair<GPUResourceId, ResourceT &>(id, this->pages[page]->at(offset).first)};
+        /**
+         * @brief   Same as try_reserve_indices, but grows the pool until the indices fit, see try_create_slot_or_grow.
+         *
+         * Always threadsafe.
+         * @return false if the pool can not grow enough. Nothing is reserved in that case.
+         */
+        template <typename GrowFnT>
+        auto try_reserve_indices_or_grow(std::span<u32> out_indices, GrowFnT const & grow_fn) -> bool
+        {
+            while (true)
+            {
+                u32 const observed_max_resources = this->max_resources.load(std::memory_order_acquire);
+                if (this->try_reserve_indices(out_indices))
+                {
+                    return true;
+                }
+                if (!grow_fn(observed_max_resources))
+                {
+                    return false;
+                }
+            }
+        }
+
+        auto try_reserve_indices_or_grow(std::span<u32> out_indices) -> bool
+        {
+            return this->try_reserve_indices_or_grow(
+                out_indices,
+                [this](u32 observed_max_resources)
+                {
+                    return this->try_grow(observed_max_resources);
+                });
+        }
+
+        /**
+         * @brief   Creates the slot of an index reserved with try_reserve_indices.
+         *          Sets the index to CONSUMED_RESERVED_INDEX, it must not be released anymore.
+         *
+         * Always threadsafe.
+         * @return The new resource slot and its id, always has a value.
+         */
+        auto create_reserved_slot(u32 & reserved_index) -> std::optional<SlotRef>
+        {
+            return std::optional<SlotRef>{this->create_slot_at(std::exchange(reserved_index, CONSUMED_RESERVED_INDEX))};
+        }
+
+        /**
+         * @brief   Hands back an index reserved with try_reserve_indices that never became a slot.
+         *
+         * Always threadsafe.
+         */
+        void release_reserved_index(u32 index)
+        {
+            // Fresh indices may lie in a page that was never allocated, the free list links live in the pages.
+            this->ensure_page(static_cast<usize>(index) >> PAGE_BITS);
+            this->push_free_index(index);
         }
 
         auto try_zombify(GPUResourceId id) -> bool
@@ -195,7 +489,7 @@ namespace daxa
             u64 version = id.version;
             // Explicitly mark as zombie
             u64 const new_version = (version + 1) | VERSION_ZOMBIE_BIT;
-            return (*this->pages[page])[offset].second.compare_exchange_strong(
+            return this->pages[page]->versions[offset].compare_exchange_strong(
                 version, new_version,
                 std::memory_order_relaxed,
                 std::memory_order_relaxed);
@@ -215,7 +509,7 @@ namespace daxa
             {
                 return false;
             }
-            u64 const slot_version = (*this->pages[page])[offset].second.load(std::memory_order_relaxed);
+            u64 const slot_version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             return slot_version == id.version;
         }
 
@@ -232,7 +526,7 @@ namespace daxa
             {
                 return 0;
             }
-            return (*this->pages[page])[offset].second.load(std::memory_order_relaxed);
+            return this->pages[page]->versions[offset].load(std::memory_order_relaxed);
         }
 
         /**
@@ -251,43 +545,209 @@ namespace daxa
             // Clamp so we get some random slot in error case but never invalid memory!
             page = std::min(static_cast<usize>(this->valid_page_count.load(std::memory_order_relaxed)) - 1, page);
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
-            return pages[page]->at(offset).first;
+            return pages[page]->slots[offset];
+        }
+
+        /**
+         * @brief   Same as unsafe_get, but returns the cold data (create info, name) of the slot.
+         *
+         * Only Threadsafe when:
+         * * resource is not destroyed before the reference is used for the last time.
+         *
+         * @returns cold resource data.
+         */
+        auto unsafe_get_cold(GPUResourceId id) const -> ColdResourceT const &
+        {
+            auto page = static_cast<usize>(id.index) >> PAGE_BITS;
+            page = std::min(static_cast<usize>(this->valid_page_count.load(std::memory_order_relaxed)) - 1, page);
+            auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
+            return cold_pages[page]->slots[offset];
         }
     };
 
+    // Storage of the resource table when the VK_EXT_descriptor_buffer backend is used.
+    // The table lives in one host visible buffer, instead of an update after bind descriptor set allocated from a pool.
+    struct DescriptorBuffer
+    {
+        VmaAllocator vma_allocator = {};
+        VkBuffer vk_buffer = {};
+        VmaAllocation vma_allocation = {};
+        std::byte * host_ptr = {};
+        VkDeviceSize size = {};
+        VkBufferUsageFlags usage = {};
+        // The buffer is shared by all queues, recreating it on growth needs them again.
+        std::vector<u32> queue_families = {};
+        // Indexed with the DAXA_*_BINDING values.
+        std::array<VkDeviceSize, 7> binding_offsets = {};
+        usize storage_buffer_descriptor_size = {};
+        usize storage_image_descriptor_size = {};
+        usize sampled_image_descriptor_size = {};
+        usize sampler_descriptor_size = {};
+        usize acceleration_structure_descriptor_size = {};
+        PFN_vkGetDescriptorEXT vkGetDescriptorEXT = {};
+        PFN_vkCmdBindDescriptorBuffersEXT vkCmdBindDescriptorBuffersEXT = {};
+        PFN_vkCmdSetDescriptorBufferOffsetsEXT vkCmdSetDescriptorBufferOffsetsEXT = {};
+    };
+
+    // Passed to GPUShaderResourceTable::initialize to request the descriptor buffer backend.
+    // The table falls back to a descriptor set when the layout does not fit the descriptor buffer limits.
+    struct DescriptorBufferInitInfo
+    {
+        VmaAllocator vma_allocator = {};
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT const * properties = {};
+        bool robust_buffer_access = {};
+        u32 queue_family_count = {};
+        u32 const * queue_families = {};
+        PFN_vkGetDescriptorSetLayoutSizeEXT vkGetDescriptorSetLayoutSizeEXT = {};
+        PFN_vkGetDescriptorSetLayoutBindingOffsetEXT vkGetDescriptorSetLayoutBindingOffsetEXT = {};
+        PFN_vkGetDescriptorEXT vkGetDescriptorEXT = {};
+        PFN_vkCmdBindDescriptorBuffersEXT vkCmdBindDescriptorBuffersEXT = {};
+        PFN_vkCmdSetDescriptorBufferOffsetsEXT vkCmdSetDescriptorBufferOffsetsEXT = {};
+    };
+
+    // Storage of the table replaced when the buffer slots grow.
+    // Kept alive until the gpu is done with all submits that may still read it.
+    struct RetiredTableStorage
+    {
+        VkDescriptorPool vk_descriptor_pool = {};
+        VkBuffer descriptor_buffer = {};
+        VmaAllocation descriptor_buffer_allocation = {};
+    };
+
+    /**
+     * @brief   Collects descriptor writes into the resource table, so that many of them can be issued with a single vkUpdateDescriptorSets call.
+     * With the descriptor buffer backend they are written straight into the mapped buffer instead.
+     *
+     * Not threadsafe.
+     */
+    struct DescriptorWriteBatch
+    {
+        struct Write
+        {
+            u32 binding = {};
+            u32 index = {};
+            VkDescriptorType type = {};
+            // Indexes buffer_infos, image_infos or acceleration_structures, depending on the descriptor type.
+            u32 info_index = {};
+        };
+        std::vector<Write> writes = {};
+        std::vector<VkDescriptorBufferInfo> buffer_infos = {};
+        std::vector<VkDescriptorImageInfo> image_infos = {};
+        std::vector<VkAccelerationStructureKHR> acceleration_structures = {};
+        // Scratch memory for flush, kept around to avoid reallocation.
+        std::vector<u32> sorted_write_indices = {};
+        std::vector<VkDescriptorBufferInfo> sorted_buffer_infos = {};
+        std::vector<VkDescriptorImageInfo> sorted_image_infos = {};
+        std::vector<VkAccelerationStructureKHR> sorted_acceleration_structures = {};
+        std::vector<VkWriteDescriptorSet> vk_writes = {};
+        std::vector<VkWriteDescriptorSetAccelerationStructureKHR> vk_acceleration_structure_writes = {};
+
+        // Only read by the descriptor buffer backend, parallel to buffer_infos and acceleration_structures.
+        std::vector<VkDeviceAddress> buffer_device_addresses = {};
+        std::vector<VkDeviceAddress> acceleration_structure_device_addresses = {};
+
+        void reserve(usize write_count);
+        void add_sampler(VkSampler vk_sampler, u32 index);
+        void add_buffer(VkBuffer vk_buffer, VkDeviceAddress device_address, VkDeviceSize offset, VkDeviceSize range, u32 index);
+        void add_image(VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
+        void add_acceleration_structure(VkAccelerationStructureKHR vk_acceleration_structure, VkDeviceAddress device_address, u32 index);
+        // Appends all writes of other after the writes of this batch.
+        void append(DescriptorWriteBatch const & other);
+        auto empty() const -> bool;
+        void clear();
+        // Issues all writes in a single vkUpdateDescriptorSets call and clears the batch.
+        // Multiple writes to the same descriptor are collapsed into the last one.
+        // Writes to neighbouring array elements of a binding are merged into one VkWriteDescriptorSet.
+        void flush(VkDevice vk_device, VkDescriptorSet vk_descriptor_set);
+        // Writes all descriptors with vkGetDescriptorEXT straight into the mapped descriptor buffer and clears the batch.
+        // Writes are applied in queue order, so the last write to a descriptor wins.
+        void flush(VkDevice vk_device, DescriptorBuffer const & descriptor_buffer);
+    };
+
     struct GPUShaderResourceTable
     {
-        std::shared_mutex lifetime_lock = {};
-        GpuResourcePool<ImplBufferSlot> buffer_slots = {};
-        GpuResourcePool<ImplImageSlot> image_slots = {};
-        GpuResourcePool<ImplSamplerSlot> sampler_slots = {};
-        GpuResourcePool<ImplTlasSlot> tlas_slots = {};
-        GpuResourcePool<ImplBlasSlot> blas_slots = {};
+        GpuResourcePool<ImplBufferSlot, ImplBufferColdSlot> buffer_slots = {};
+        GpuResourcePool<ImplImageSlot, ImplImageColdSlot> image_slots = {};
+        GpuResourcePool<ImplSamplerSlot, ImplSamplerColdSlot> sampler_slots = {};
+        GpuResourcePool<ImplTlasSlot, ImplTlasColdSlot> tlas_slots = {};
+        GpuResourcePool<ImplBlasSlot, ImplBlasColdSlot> blas_slots = {};
 
+        // The storage buffer binding is the highest binding and has a variable descriptor count.
+        // The layout declares it for the growth limit, the set or descriptor buffer is only allocated for the current buffer capacity.
         VkDescriptorSetLayout vk_descriptor_set_layout = {};
-        VkDescriptorSet vk_descriptor_set = {};
+        // Swapped when the table grows, recorders read it without locking.
+        std::atomic<VkDescriptorSet> vk_descriptor_set = {};
         VkDescriptorPool vk_descriptor_pool = {};
+        // Only used when the table lives in a descriptor buffer, vk_descriptor_set and vk_descriptor_pool are null then.
+        std::optional<DescriptorBuffer> descriptor_buffer = {};
+        // Swapped when the table grows, recorders read it without locking.
+        std::atomic_uint64_t descriptor_buffer_device_address = {};
+        // Incremented each time the table storage is reallocated.
+        // Recorders compare it when a pipeline is set and rebind the table when it changed.
+        std::atomic_uint32_t generation = {};
+        PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT = {};
+        // Pipelines using the table must be created with these flags.
+        VkPipelineCreateFlags vk_pipeline_create_flags = {};
 
         // Contains pipeline layouts with varying push constant range size.
         // The first size is 0 word, second is 1 word, all others are a power of two (maximum is DAXA_MAX_PUSH_CONSTANT_BYTE_SIZE).
         std::array<VkPipelineLayout, DAXA_PIPELINE_LAYOUT_COUNT> pipeline_layouts = {};
 
+        // Writes into the table are not issued immediately.
+        // They are queued and flushed in one coalesced update on submit and collect_garbage.
+        // This is valid, as the gpu can only see a new descriptor after a submit that uses it.
+        std::mutex pending_descriptor_writes_mtx = {};
+        DescriptorWriteBatch pending_descriptor_writes = {};
+        // Statistics, see daxa_dvc_stats.
+        ShardedCounter descriptor_write_count = {};
+        std::atomic_uint64_t descriptor_write_flush_count = {};
+
         auto initialize(
             u32 max_buffers,
             u32 max_images,
             u32 max_samplers,
             u32 max_acceleration_structures,
+            u32 max_growable_buffers,
+            u32 max_growable_images,
+            u32 max_growable_samplers,
             VkDevice device,
             VkBuffer device_address_buffer,
-            PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT) -> daxa_Result;
+            PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT,
+            DescriptorBufferInitInfo const * opt_descriptor_buffer_info = nullptr) -> daxa_Result;
         void cleanup(VkDevice device);
-    };
 
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index);
+        /**
+         * @brief   Reallocates the descriptor set or buffer with room for buffer_count storage buffers.
+         *          Flushes queued writes, copies all live descriptors into the new storage and points the buffer device address binding at device_address_buffer.
+         *          Commands recorded before the growth keep using the old storage, it must stay alive until the gpu is done with them.
+         *
+         * Threadsafe with queuing and flushing writes. Must not be called concurrently with itself.
+         */
+        auto grow(VkDevice device, u32 buffer_count, VkBuffer device_address_buffer, VkDeviceAddress device_address_buffer_address, RetiredTableStorage & out_retired) -> daxa_Result;
+
+        // Must be recorded once at the start of every command buffer, does nothing for the descriptor set backend.
+        void bind_descriptor_buffer(VkCommandBuffer vk_cmd_buffer) const;
+        void bind(VkCommandBuffer vk_cmd_buffer, VkPipelineBindPoint vk_bind_point, VkPipelineLayout vk_pipeline_layout) const;
 
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index);
+        // Points the buffer device address binding of the current storage to device_address_buffer.
+        // Must be called with pending_descriptor_writes_mtx locked.
+        void write_buffer_device_address_buffer(VkDevice device, VkBuffer device_address_buffer, VkDeviceAddress device_address_buffer_address, u32 buffer_count);
 
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
+        void queue_sampler_write(VkSampler vk_sampler, u32 index);
+        void queue_buffer_write(VkBuffer vk_buffer, VkDeviceAddress device_address, VkDeviceSize offset, VkDeviceSize range, u32 index);
+        void queue_image_write(VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
+        void queue_acceleration_structure_write(VkAccelerationStructureKHR vk_acceleration_structure, VkDeviceAddress device_address, u32 index);
+        // Moves all writes of the batch into the queue, leaving the batch empty.
+        void queue_writes(DescriptorWriteBatch & batch);
+        // Does not need to sync with the gpu given we use update after bind.
+        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // The same holds for the descriptor buffer, the gpu never reads descriptors of slots that are written here.
+        void flush_descriptor_writes(VkDevice device);
 
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index);
+        // Allocate the table storage with room for buffer_count storage buffer descriptors.
+        auto create_descriptor_set(VkDevice device, u32 buffer_count, VkDescriptorPool & out_pool, VkDescriptorSet & out_set) -> daxa_Result;
+        auto create_descriptor_buffer(VkDevice device, u32 buffer_count, DescriptorBuffer & db, VkDeviceAddress & out_device_address) -> daxa_Result;
+        // Must be called with pending_descriptor_writes_mtx locked.
+        void flush_descriptor_writes_locked(VkDevice device);
+    };
 } // namespace daxa
@@ -236,11 +236,13 @@ auto daxa_instance_choose_device(daxa_Instance self, daxa_ImplicitFeatureFlags d
 
         bool const no_support_problems = props.missing_required_feature == DAXA_MISSING_REQUIRED_VK_FEATURE_NONE;
 
+        u32 const max_buffers = std::max(info->max_allowed_buffers, info->max_growable_buffers);
+        u32 const max_images = std::max(info->max_allowed_images, info->max_growable_images);
         bool matches_info =
-            info->max_allowed_buffers <= props.limits.max_descriptor_set_storage_buffers &&
-            info->max_allowed_images <= props.limits.max_descriptor_set_storage_images &&
-            info->max_allowed_images <= props.limits.max_descriptor_set_sampled_images &&
-            info->max_allowed_images <= props.limits.max_descriptor_set_storage_images;
+            max_buffers <= props.limits.max_descriptor_set_storage_buffers &&
+            max_images <= props.limits.max_descriptor_set_storage_images &&
+            max_images <= props.limits.max_descriptor_set_sampled_images &&
+            max_images <= props.limits.max_descriptor_set_storage_images;
         if (props.acceleration_structure_properties.has_value)
         {
             matches_info = matches_info &&
@@ -295,7 +295,7 @@ auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo
     VkGraphicsPipelineCreateInfo const vk_graphics_pipeline_create_info{
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
         .pNext = &vk_pipeline_rendering,
-        .flags = {},
+        .flags = ret.device->gpu_sro_table.vk_pipeline_create_flags,
         .stageCount = static_cast<u32>(vk_pipeline_shader_stage_create_infos.size()),
         .pStages = vk_pipeline_shader_stage_create_infos.data(),
         .pVertexInputState = &vk_vertex_input_state,
@@ -405,7 +405,7 @@ auto daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineIn
     VkComputePipelineCreateInfo const vk_compute_pipeline_create_info{
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
         .pNext = nullptr,
-        .flags = {},
+        .flags = ret.device->gpu_sro_table.vk_pipeline_create_flags,
         .stage = VkPipelineShaderStageCreateInfo{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
             .pNext = uses_required_subgroup_size ? &require_subgroup_size_vkstruct : nullptr,
@@ -629,7 +629,7 @@ auto daxa_dvc_create_ray_tracing_pipeline_or_library(daxa_Device device, daxa_Ra
     VkRayTracingPipelineCreateInfoKHR vk_ray_tracing_pipeline_create_info{
         .sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR,
         .pNext = nullptr,
-        .flags = {},
+        .flags = ret.device->gpu_sro_table.vk_pipeline_create_flags,
         .stageCount = stages_count,
         .pStages = stages.data(),
         .groupCount = group_count,
@@ -669,7 +669,7 @@ auto daxa_dvc_create_ray_tracing_pipeline_or_library(daxa_Device device, daxa_Ra
     }
     else
     {
-        vk_ray_tracing_pipeline_create_info.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+        vk_ray_tracing_pipeline_create_info.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
         vk_ray_tracing_pipeline_create_info.pLibraryInterface = &library_interface_info;
     }
 
@@ -991,13 +991,13 @@ void ImplPipeline::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("ImplPipeline::zero_ref_callback\n");
     auto * self = rc_cast<ImplPipeline *>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const submit_timeline_value = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->pipeline_zombies.emplace_front(
+    self->device->pipeline_zombies.push(
         submit_timeline_value,
         PipelineZombie{
             .vk_pipeline = self->vk_pipeline,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
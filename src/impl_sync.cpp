@@ -214,13 +214,13 @@ auto daxa_event_dec_refcnt(daxa_Event self) -> u64
 void daxa_ImplBinarySemaphore::zero_ref_callback(ImplHandle const * handle)
 {
     auto * self = rc_cast<daxa_BinarySemaphore>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const main_queue_cpu_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->semaphore_zombies.emplace_back(
+    self->device->semaphore_zombies.push(
         main_queue_cpu_timeline,
         SemaphoreZombie{
             .vk_semaphore = self->vk_semaphore,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -231,13 +231,13 @@ void daxa_ImplTimelineSemaphore::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("daxa_ImplTimelineSemaphore::zero_ref_callback\n");
     auto * self = rc_cast<daxa_TimelineSemaphore>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const main_queue_cpu_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->semaphore_zombies.emplace_back(
+    self->device->semaphore_zombies.push(
         main_queue_cpu_timeline,
         SemaphoreZombie{
             .vk_semaphore = self->vk_semaphore,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -247,13 +247,13 @@ void daxa_ImplTimelineSemaphore::zero_ref_callback(ImplHandle const * handle)
 void daxa_ImplEvent::zero_ref_callback(ImplHandle const * handle)
 {
     auto * self = rc_cast<daxa_Event>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const main_queue_cpu_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->split_barrier_zombies.emplace_back(
+    self->device->split_barrier_zombies.push(
         main_queue_cpu_timeline,
         EventZombie{
             .vk_event = self->vk_event,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -92,13 +92,13 @@ auto daxa_timeline_query_pool_dec_refcnt(daxa_TimelineQueryPool self) -> u64
 void daxa_ImplTimelineQueryPool::zero_ref_callback(ImplHandle const * handle)
 {
     auto * self = rc_cast<daxa_TimelineQueryPool>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const submit_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->timeline_query_pool_zombies.emplace_back(
+    self->device->timeline_query_pool_zombies.push(
         submit_timeline,
         TimelineQueryPoolZombie{
             .vk_timeline_query_pool = self->vk_timeline_query_pool,
         });
+    self->device->notify_garbage_collector();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -1,6 +1,9 @@
 #if DAXA_BUILT_WITH_UTILS_MEM
 
 #include <daxa/utils/mem.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <utility>
 
 namespace daxa
@@ -165,6 +168,219 @@ namespace daxa
     {
         return this->m_buffer;
     }
+
+    UploadEngine::UploadEngine(UploadEngineInfo a_info)
+        : m_info{std::move(a_info)},
+          gpu_timeline{this->m_info.device.create_timeline_semaphore({
+              .initial_value = {},
+              .name = this->m_info.name,
+          })}
+    {
+        DAXA_DBG_ASSERT_TRUE_M(this->m_info.pool_count > 0, "upload engine needs at least one staging pool");
+        this->pools.reserve(this->m_info.pool_count);
+        for (u32 pool_i = 0; pool_i < this->m_info.pool_count; ++pool_i)
+        {
+            this->pools.push_back(TransferMemoryPool{TransferMemoryPoolInfo{
+                .device = this->m_info.device,
+                .capacity = this->m_info.pool_capacity,
+                .use_bar_memory = this->m_info.use_bar_memory,
+                .name = this->m_info.name + " staging " + std::to_string(pool_i),
+            }});
+        }
+        this->pool_submit_values.resize(this->m_info.pool_count, 0);
+    }
+
+    UploadEngine::~UploadEngine()
+    {
+        // Pending copies must still be submitted, the staging buffers are destroyed deferred until the gpu finished them.
+        this->flush();
+    }
+
+    auto UploadEngine::upload(BufferId dst_buffer, std::span<std::byte const> data, usize dst_offset) -> UploadTicket
+    {
+        usize const max_chunk_size = this->m_info.pool_capacity / 2;
+        UploadTicket ticket = {};
+        for (usize offset = 0; offset < data.size(); offset += max_chunk_size)
+        {
+            u32 const chunk_size = static_cast<u32>(std::min(data.size() - offset, max_chunk_size));
+            StagingAllocation const staging = this->stage(chunk_size);
+            std::memcpy(staging.allocation.host_address, data.data() + offset, chunk_size);
+            this->add_copy(BufferCopyInfo{
+                .src_buffer = staging.staging_buffer,
+                .dst_buffer = dst_buffer,
+                .src_offset = staging.allocation.buffer_offset,
+                .dst_offset = dst_offset + offset,
+                .size = chunk_size,
+            });
+            ticket.timeline_value = staging.batch_value;
+        }
+        return ticket;
+    }
+
+    auto UploadEngine::upload(ImageId dst_image, std::span<std::byte const> data, UploadImageRegion const & region) -> std::optional<UploadTicket>
+    {
+        // Images have either multiple array layers or a depth, both split the tightly packed data into equally sized slices.
+        // Any run of consecutive slices is a box again, so the upload can be split between slices.
+        bool const split_layers = region.image_slice.layer_count > 1;
+        u32 const slice_count = split_layers ? region.image_slice.layer_count : std::max(region.image_extent.z, 1u);
+        usize const slice_size = data.size() / slice_count;
+        usize const max_chunk_size = this->m_info.pool_capacity / 2;
+        if (slice_size > max_chunk_size || slice_size * slice_count != data.size())
+        {
+            return std::nullopt;
+        }
+        if (data.empty())
+        {
+            return UploadTicket{};
+        }
+        u32 const slices_per_chunk = static_cast<u32>(std::min(max_chunk_size / slice_size, usize{slice_count}));
+        UploadTicket ticket = {};
+        for (u32 first_slice = 0; first_slice < slice_count; first_slice += slices_per_chunk)
+        {
+            u32 const chunk_slices = std::min(slices_per_chunk, slice_count - first_slice);
+            usize const chunk_size = chunk_slices * slice_size;
+            StagingAllocation const staging = this->stage(static_cast<u32>(chunk_size));
+            std::memcpy(staging.allocation.host_address, data.data() + first_slice * slice_size, chunk_size);
+            BufferImageCopyInfo copy = {
+                .buffer = staging.staging_buffer,
+                .buffer_offset = staging.allocation.buffer_offset,
+                .image = dst_image,
+                .image_layout = region.image_layout,
+                .image_slice = region.image_slice,
+                .image_offset = region.image_offset,
+                .image_extent = region.image_extent,
+            };
+            if (split_layers)
+            {
+                copy.image_slice.base_array_layer += first_slice;
+                copy.image_slice.layer_count = chunk_slices;
+            }
+            else
+            {
+                copy.image_offset.z += static_cast<i32>(first_slice);
+                copy.image_extent.z = chunk_slices;
+            }
+            this->add_copy(copy);
+            ticket.timeline_value = staging.batch_value;
+        }
+        return ticket;
+    }
+
+    auto UploadEngine::flush() -> UploadTicket
+    {
+        std::unique_lock lock{this->mtx};
+        this->flush_locked(lock);
+        return UploadTicket{this->batch_value - 1};
+    }
+
+    auto UploadEngine::is_complete(UploadTicket ticket) const -> bool
+    {
+        return this->gpu_timeline.value() >= ticket.timeline_value;
+    }
+
+    auto UploadEngine::timeline_semaphore() const -> TimelineSemaphore const &
+    {
+        return this->gpu_timeline;
+    }
+
+    auto UploadEngine::info() const -> UploadEngineInfo const &
+    {
+        return this->m_info;
+    }
+
+    auto UploadEngine::stage(u32 size) -> StagingAllocation
+    {
+        std::unique_lock lock{this->mtx};
+        // Copying into the staging memory happens outside the lock, so that uploads of multiple threads overlap.
+        while (true)
+        {
+            this->flush_cv.wait(lock, [&]
+                                { return !this->flushing; });
+            TransferMemoryPool & pool = this->pools[this->current_pool];
+            // Texel blocks are at most 16 bytes, so 16 byte alignment suits image copies too.
+            auto allocation = pool.allocate(size, 16);
+            if (allocation.has_value())
+            {
+                this->pending_writes += 1;
+                return StagingAllocation{
+                    .allocation = allocation.value(),
+                    .staging_buffer = pool.buffer(),
+                    .batch_value = this->batch_value,
+                };
+            }
+            if (!this->pending_copies.empty() || this->pending_writes > 0)
+            {
+                // The pool is full with the current batch, submit it and continue with the next pool.
+                this->flush_locked(lock);
+            }
+            else
+            {
+                // The pool is still in use by earlier batches, wait for the gpu to release it.
+                // Other threads may add copies or flush meanwhile, so the lock is released and the state is checked again afterwards.
+                TimelineSemaphore pool_timeline = pool.timeline_semaphore();
+                u64 const pool_submit_value = this->pool_submit_values[this->current_pool];
+                lock.unlock();
+                [[maybe_unused]] bool const finished = pool_timeline.wait_for_value(pool_submit_value);
+                lock.lock();
+            }
+        }
+    }
+
+    void UploadEngine::add_copy(Variant<BufferCopyInfo, BufferImageCopyInfo> const & copy)
+    {
+        std::unique_lock lock{this->mtx};
+        this->pending_copies.push_back(copy);
+        this->pending_writes -= 1;
+        if (this->pending_writes == 0)
+        {
+            this->flush_cv.notify_all();
+        }
+    }
+
+    void UploadEngine::flush_locked(std::unique_lock<std::mutex> & lock)
+    {
+        this->flush_cv.wait(lock, [&]
+                            { return !this->flushing; });
+        this->flushing = true;
+        // Staging writes in progress belong to this batch, they must finish before it is submitted.
+        this->flush_cv.wait(lock, [&]
+                            { return this->pending_writes == 0; });
+        if (!this->pending_copies.empty())
+        {
+            CommandRecorder recorder = this->m_info.device.create_command_recorder({
+                .queue_family = this->m_info.queue.family,
+                .name = this->m_info.name,
+            });
+            for (auto const & copy : this->pending_copies)
+            {
+                if (auto const * buffer_copy = daxa::get_if<BufferCopyInfo>(&copy))
+                {
+                    recorder.copy_buffer_to_buffer(*buffer_copy);
+                }
+                else if (auto const * image_copy = daxa::get_if<BufferImageCopyInfo>(&copy))
+                {
+                    recorder.copy_buffer_to_image(*image_copy);
+                }
+            }
+            ExecutableCommandList const commands = recorder.complete_current_commands();
+            TransferMemoryPool & pool = this->pools[this->current_pool];
+            this->pool_submit_values[this->current_pool] = pool.inc_timeline_value();
+            std::array<std::pair<TimelineSemaphore, u64>, 2> const signals = {
+                std::pair{this->gpu_timeline, this->batch_value},
+                std::pair{pool.timeline_semaphore(), this->pool_submit_values[this->current_pool]},
+            };
+            this->m_info.device.submit_commands({
+                .queue = this->m_info.queue,
+                .command_lists = std::span{&commands, 1},
+                .signal_timeline_semaphores = signals,
+            });
+            this->pending_copies.clear();
+            this->batch_value += 1;
+            this->current_pool = (this->current_pool + 1) % this->pools.size();
+        }
+        this->flushing = false;
+        this->flush_cv.notify_all();
+    }
 } // namespace daxa
 
 #endif
@@ -382,6 +382,24 @@ namespace daxa
         return {access, concurrent};
     }
 
+    auto queue_flat_index(Queue queue) -> usize
+    {
+        switch (queue.family)
+        {
+        case QueueFamily::COMPUTE: return 1 + queue.index;
+        case QueueFamily::TRANSFER: return 1 + DAXA_MAX_COMPUTE_QUEUE_COUNT + queue.index;
+        default: return 0;
+        }
+    }
+
+    void add_submit_scope_wait(TaskBatchSubmitScope & scope, usize wait_submit_scope_index)
+    {
+        if (std::find(scope.wait_submit_scope_indices.begin(), scope.wait_submit_scope_indices.end(), wait_submit_scope_index) == scope.wait_submit_scope_indices.end())
+        {
+            scope.wait_submit_scope_indices.push_back(wait_submit_scope_index);
+        }
+    }
+
     auto TaskGPUResourceView::is_empty() const -> bool
     {
         return index == 0 && task_graph_index == 0;
@@ -1529,6 +1547,60 @@ namespace daxa
 #endif // #if DAXA_VALIDATION
     }
 
+    // Task graph does not transfer queue family ownership, tasks on async queues access persistent images directly.
+    // That is only defined for images created with concurrent sharing, exclusive images would need release and acquire barriers.
+    void validate_async_queue_image_sharing([[maybe_unused]] ImplTaskGraph const & impl, [[maybe_unused]] TaskGraphPermutation const & permutation)
+    {
+#if DAXA_VALIDATION
+        if (!permutation.uses_async_queues)
+        {
+            return;
+        }
+        for (auto const & submit_scope : permutation.batch_submit_scopes)
+        {
+            if (submit_scope.queue.family == QueueFamily::MAIN)
+            {
+                continue;
+            }
+            for (auto const & batch : submit_scope.task_batches)
+            {
+                for (TaskId const task_id : batch.tasks)
+                {
+                    ImplTask const & task = impl.tasks[task_id];
+                    for_each(
+                        task.base_task->attachments(),
+                        [](u32, auto const &) {},
+                        [&](u32, TaskImageAttachmentInfo const & image_attach)
+                        {
+                            if (image_attach.view.is_null() || !impl.global_image_infos.at(image_attach.translated_view.index).is_persistent())
+                            {
+                                return;
+                            }
+                            for (ImageId const image : impl.get_actual_images(image_attach.translated_view, permutation))
+                            {
+                                // Invalid ids are reported by validate_runtime_resources.
+                                if (!impl.info.device.is_id_valid(image))
+                                {
+                                    continue;
+                                }
+                                DAXA_DBG_ASSERT_TRUE_MS(
+                                    impl.info.device.image_info(image).value().sharing_mode == SharingMode::CONCURRENT,
+                                    std::format(
+                                        "Detected persistent task image \"{}\" used by task \"{}\" on an async queue in task graph \"{}\", "
+                                        "but its runtime image \"{}\" was not created with SharingMode::CONCURRENT. "
+                                        "Images used on compute or transfer queues by a task graph must be created concurrent",
+                                        impl.global_image_infos.at(image_attach.translated_view.index).get_name(),
+                                        task.base_task->name(),
+                                        impl.info.name,
+                                        impl.info.device.image_info(image).value().name.view()));
+                            }
+                        });
+                }
+            }
+        }
+#endif // #if DAXA_VALIDATION
+    }
+
     constexpr usize ATTACHMENT_BLOB_MAX_SIZE = 8192;
 
     auto write_attachment_shader_blob(Device const & device, [[maybe_unused]] u32 data_size, std::span<TaskAttachmentInfo const> attachments) -> std::array<std::byte, ATTACHMENT_BLOB_MAX_SIZE>
@@ -2153,6 +2225,24 @@ namespace daxa
                 }
             });
 
+        // A task on another queue than the current submit scope implicitly submits the scope and starts a new one on its queue.
+        // The first scope always stays on the main queue, it records the synchronization of persistent resources.
+        Queue const task_queue = task.queue();
+        if (queue_flat_index(task_queue) != queue_flat_index(this->batch_submit_scopes.back().queue))
+        {
+            if (this->batch_submit_scopes.size() == 1 || !this->batch_submit_scopes.back().task_batches.empty())
+            {
+                this->batch_submit_scopes.emplace_back();
+            }
+            this->batch_submit_scopes.back().queue = task_queue;
+            if (task_queue.family != QueueFamily::MAIN)
+            {
+                this->uses_async_queues = true;
+                // Async scopes start after the first scope and therefore after the synchronization of persistent resources.
+                add_submit_scope_wait(this->batch_submit_scopes.back(), 0);
+            }
+        }
+
         usize const current_submit_scope_index = this->batch_submit_scopes.size() - 1;
         TaskBatchSubmitScope & current_submit_scope = this->batch_submit_scopes[current_submit_scope_index];
 
@@ -2229,7 +2319,30 @@ namespace daxa
                 bool const last_access_concurrent_and_external =
                     daxa::holds_alternative<Monostate>(task_buffer.latest_concurrent_access_barrer_index) &&
                     (relation.is_previous_read || relation.is_previous_rw_concurrent);
-                if (!relation.is_previous_none && !last_access_concurrent_and_external)
+                // Barriers and events can not synchronize with other queues.
+                // Instead the scope waits on the timeline semaphore signal of the scope that accessed the buffer last, which makes all its writes visible.
+                bool const previous_access_on_other_queue =
+                    !relation.is_previous_none &&
+                    queue_flat_index(this->batch_submit_scopes[task_buffer.latest_access_submit_scope_index].queue) != queue_flat_index(current_submit_scope.queue);
+                if (previous_access_on_other_queue)
+                {
+                    add_submit_scope_wait(current_submit_scope, task_buffer.latest_access_submit_scope_index);
+                    task_buffer.latest_concurrent_access_barrer_index = Monostate{};
+                    if (relation.is_current_concurrent)
+                    {
+                        // Following concurrent accesses on this queue extend this barrier, following writes need a real barrier after this access.
+                        usize const barrier_index = this->barriers.size();
+                        this->barriers.push_back(TaskBarrier{
+                            .image_id = {}, // {} signals that this is not an image barrier.
+                            .src_access = AccessConsts::NONE,
+                            .dst_access = current_buffer_access,
+                        });
+                        batch.pipeline_barrier_indices.push_back(barrier_index);
+                        task_buffer.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
+                        task_buffer.latest_concurrent_sequence_start_batch = batch_index;
+                    }
+                }
+                else if (!relation.is_previous_none && !last_access_concurrent_and_external)
                 {
                     if (relation.are_both_concurrent)
                     {
@@ -2441,8 +2554,34 @@ namespace daxa
                         // To be able to do this the layout of the image slice must also match.
                         // If they differ we need to insert an execution barrier with a layout transition.
                         AccessRelation<decltype(tracked_slice)> relation{tracked_slice, current_image_access, current_access_concurrency, tracked_slice.state.latest_layout, current_image_layout};
+                        // Accesses on other queues are synchronized by waiting on the timeline semaphore signal of their submit scope.
+                        // Only a layout transition is left to do, it needs no source access as the semaphore wait already covers it.
+                        bool const previous_access_on_other_queue =
+                            queue_flat_index(this->batch_submit_scopes[tracked_slice.latest_access_submit_scope_index].queue) != queue_flat_index(current_submit_scope.queue);
+                        if (previous_access_on_other_queue)
+                        {
+                            add_submit_scope_wait(current_submit_scope, tracked_slice.latest_access_submit_scope_index);
+                            if (!relation.are_layouts_identical || relation.is_current_concurrent)
+                            {
+                                usize const barrier_index = this->barriers.size();
+                                this->barriers.push_back(TaskBarrier{
+                                    .image_id = used_image_t_id,
+                                    .slice = intersection,
+                                    .layout_before = tracked_slice.state.latest_layout,
+                                    .layout_after = current_image_layout,
+                                    .src_access = AccessConsts::NONE,
+                                    .dst_access = current_image_access,
+                                });
+                                batch.pipeline_barrier_indices.push_back(barrier_index);
+                                if (relation.is_current_concurrent)
+                                {
+                                    ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
+                                    ret_new_use_tracked_slice.latest_concurrent_sequence_start_batch = batch_index;
+                                }
+                            }
+                        }
                         // Read write concurrent and reads (implicitly concurrent) are reusing the already inserted barriers if there was a previous identical access.
-                        if (relation.are_both_concurrent_and_same_layout)
+                        else if (relation.are_both_concurrent_and_same_layout)
                         {
                             // Reuse first barrier in coherent access sequence.
                             if (auto const * index0 = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
@@ -2668,6 +2807,8 @@ namespace daxa
                             .array_layer_count = transient_image_info.array_layer_count,
                             .sample_count = transient_image_info.sample_count,
                             .usage = perm_image.usage,
+                            // Async queues access the images from other queue families.
+                            .sharing_mode = permutation.uses_async_queues ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
                             .name = transient_image_info.name,
                         },
                         .memory_block = transient_data_memory_block,
@@ -2700,6 +2841,7 @@ namespace daxa
                         .array_layer_count = trans_img_info.array_layer_count,
                         .sample_count = trans_img_info.sample_count,
                         .usage = permut_image.usage,
+                        .sharing_mode = permutation.uses_async_queues ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
                         .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
                         .name = "Dummy to figure mem requirements",
                     };
@@ -2894,7 +3036,8 @@ namespace daxa
                     }};
                 usize const align = std::max(mem_requirements.alignment, static_cast<size_t>(1ull));
 
-                if (info.alias_transients)
+                // Batches of different queues overlap in time, their batch indices can not be used for aliasing.
+                if (info.alias_transients && !permutation.uses_async_queues)
                 {
                     // TODO(msakmary) Fix the intersect functionality so that it is general and does not do hacky stuff like constructing
                     // a mip array slice
@@ -2958,6 +3101,7 @@ namespace daxa
         {
             impl.create_transient_runtime_buffers(permutation);
             impl.create_transient_runtime_images(permutation);
+            validate_async_queue_image_sharing(impl, permutation);
 
             // Insert static initialization barriers for non persistent resources:
             // Buffers never need layout initialization, only images.
@@ -3305,13 +3449,77 @@ namespace daxa
         ImplTaskRuntimeInterface impl_runtime{.task_graph = impl, .permutation = permutation, .recorder = recorder};
 
         validate_runtime_resources(impl, permutation);
+        // Runtime images may have been exchanged since the graph was completed.
+        validate_async_queue_image_sharing(impl, permutation);
         // Generate and insert synchronization for persistent resources:
         generate_persistent_resource_synch(impl, permutation, recorder);
 
+        // Submits are collected and issued together, one queue submit per used queue.
+        // They are flushed before presenting and before waiting on binary semaphores that earlier submits may signal.
+        struct PendingSubmit
+        {
+            Queue queue = QUEUE_MAIN;
+            PipelineStageFlags wait_stages = {};
+            std::vector<ExecutableCommandList> commands = {};
+            std::vector<BinarySemaphore> wait_binary_semaphores = {};
+            std::vector<BinarySemaphore> signal_binary_semaphores = {};
+            std::vector<std::pair<TimelineSemaphore, u64>> wait_timeline_semaphores = {};
+            std::vector<std::pair<TimelineSemaphore, u64>> signal_timeline_semaphores = {};
+        };
+        std::vector<PendingSubmit> pending_submits = {};
+        auto flush_pending_submits = [&]()
+        {
+            if (pending_submits.empty())
+            {
+                return;
+            }
+            std::vector<CommandSubmitInfo> submit_infos = {};
+            submit_infos.reserve(pending_submits.size());
+            for (PendingSubmit const & pending : pending_submits)
+            {
+                submit_infos.push_back(CommandSubmitInfo{
+                    .queue = pending.queue,
+                    .wait_stages = pending.wait_stages,
+                    .command_lists = pending.commands,
+                    .wait_binary_semaphores = pending.wait_binary_semaphores,
+                    .signal_binary_semaphores = pending.signal_binary_semaphores,
+                    .wait_timeline_semaphores = pending.wait_timeline_semaphores,
+                    .signal_timeline_semaphores = pending.signal_timeline_semaphores,
+                });
+            }
+            impl.info.device.submit_commands_batch(submit_infos);
+            pending_submits.clear();
+        };
+
+        // Scopes on different queues are synchronized with one timeline semaphore per queue.
+        // Each submitted scope signals the next value of its queues semaphore.
+        std::vector<u64> submit_scope_signal_values(permutation.batch_submit_scopes.size());
+        if (permutation.uses_async_queues)
+        {
+            for (auto const & submit_scope : permutation.batch_submit_scopes)
+            {
+                usize const queue_index = queue_flat_index(submit_scope.queue);
+                if (!impl.queue_timeline_semaphores[queue_index])
+                {
+                    impl.queue_timeline_semaphores[queue_index] = impl.info.device.create_timeline_semaphore({
+                        .initial_value = 0,
+                        .name = impl.info.name + std::string(" queue timeline ") + std::to_string(queue_index),
+                    });
+                }
+            }
+        }
+
+        QueueFamily recorder_queue_family = QueueFamily::MAIN;
         usize submit_scope_index = 0;
         for (auto & submit_scope : permutation.batch_submit_scopes)
         {
             // PROFILE_SCOPE("Task Batch");
+            if (submit_scope.queue.family != recorder_queue_family)
+            {
+                // The previous scope completed its commands for submission, the recorder can be replaced.
+                recorder_queue_family = submit_scope.queue.family;
+                recorder = impl.info.device.create_command_recorder({.queue_family = recorder_queue_family});
+            }
             if (impl.info.enable_command_labels)
             {
                 impl_runtime.recorder.begin_label({
@@ -3539,22 +3747,40 @@ namespace daxa
                 {
                     signal_timeline_semaphores.insert(signal_timeline_semaphores.end(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->begin(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->end());
                 }
-                if (impl.staging_memory.has_value())
+                if (permutation.uses_async_queues)
+                {
+                    for (usize const wait_scope_index : submit_scope.wait_submit_scope_indices)
+                    {
+                        wait_timeline_semaphores.emplace_back(
+                            impl.queue_timeline_semaphores[queue_flat_index(permutation.batch_submit_scopes[wait_scope_index].queue)],
+                            submit_scope_signal_values[wait_scope_index]);
+                    }
+                    usize const queue_index = queue_flat_index(submit_scope.queue);
+                    submit_scope_signal_values[submit_scope_index] = ++impl.queue_timeline_values[queue_index];
+                    signal_timeline_semaphores.emplace_back(impl.queue_timeline_semaphores[queue_index], submit_scope_signal_values[submit_scope_index]);
+                }
+                else if (impl.staging_memory.has_value())
                 {
+                    // Staging memory values must be signaled in order, with async queues the join submit after the loop signals it.
                     signal_timeline_semaphores.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
                 }
-                daxa::CommandSubmitInfo const submit_info = {
+                if (!wait_binary_semaphores.empty())
+                {
+                    flush_pending_submits();
+                }
+                pending_submits.push_back(PendingSubmit{
+                    .queue = submit_scope.queue,
                     .wait_stages = wait_stages,
-                    .command_lists = commands,
-                    .wait_binary_semaphores = wait_binary_semaphores,
-                    .signal_binary_semaphores = signal_binary_semaphores,
-                    .wait_timeline_semaphores = wait_timeline_semaphores,
-                    .signal_timeline_semaphores = signal_timeline_semaphores,
-                };
-                impl.info.device.submit_commands(submit_info);
+                    .commands = std::move(commands),
+                    .wait_binary_semaphores = std::move(wait_binary_semaphores),
+                    .signal_binary_semaphores = std::move(signal_binary_semaphores),
+                    .wait_timeline_semaphores = std::move(wait_timeline_semaphores),
+                    .signal_timeline_semaphores = std::move(signal_timeline_semaphores),
+                });
 
                 if (submit_scope.present_info.has_value())
                 {
+                    flush_pending_submits();
                     ImplPresentInfo & impl_present_info = submit_scope.present_info.value();
                     std::vector<BinarySemaphore> present_wait_semaphores = impl_present_info.binary_semaphores;
                     DAXA_DBG_ASSERT_TRUE_M(impl.info.swapchain.has_value(), "must have swapchain registered in info on creation in order to use present.");
@@ -3575,6 +3801,26 @@ namespace daxa
             ++submit_scope_index;
         }
 
+        if (permutation.uses_async_queues)
+        {
+            // Join all async queues back into the main queue.
+            // Following executions and the staging memory expect all work of this execution to be done once the main queue progressed past it.
+            PendingSubmit join_submit = {.queue = QUEUE_MAIN};
+            for (usize queue_index = 1; queue_index < DAXA_TASK_GRAPH_QUEUE_COUNT; ++queue_index)
+            {
+                if (impl.queue_timeline_semaphores[queue_index])
+                {
+                    join_submit.wait_timeline_semaphores.emplace_back(impl.queue_timeline_semaphores[queue_index], impl.queue_timeline_values[queue_index]);
+                }
+            }
+            if (impl.staging_memory.has_value())
+            {
+                join_submit.signal_timeline_semaphores.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
+            }
+            pending_submits.push_back(std::move(join_submit));
+        }
+        flush_pending_submits();
+
         // Insert pervious uses into execution info for tje next executions synch.
         for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
         {
@@ -8,6 +8,7 @@
 #include <format>
 
 #define DAXA_TASK_GRAPH_MAX_CONDITIONALS 31
+#define DAXA_TASK_GRAPH_QUEUE_COUNT (1 + DAXA_MAX_COMPUTE_QUEUE_COUNT + DAXA_MAX_TRANSFER_QUEUE_COUNT)
 
 namespace daxa
 {
@@ -147,6 +148,10 @@ namespace daxa
 
     struct TaskBatchSubmitScope
     {
+        // All tasks of a submit scope run on the same queue, a task on another queue starts a new scope.
+        Queue queue = QUEUE_MAIN;
+        // Scopes on other queues that must finish before this scope starts.
+        std::vector<usize> wait_submit_scope_indices = {};
         CommandSubmitInfo submit_info = {};
         TaskSubmitInfo user_submit_info = {};
         // These barriers are inserted after all batches and their sync.
@@ -157,6 +162,8 @@ namespace daxa
     };
 
     auto task_image_access_to_layout_access(TaskAccess const & access) -> std::tuple<ImageLayout, Access, TaskAccessConcurrency>;
+    // Main queue first, then the compute and transfer queues, same order as the device queues.
+    auto queue_flat_index(Queue queue) -> usize;
     auto task_access_to_access(TaskAccess const & access) -> std::pair<Access, TaskAccessConcurrency>;
 
     struct ImplTaskGraph;
@@ -178,6 +185,8 @@ namespace daxa
         std::vector<TaskBatchSubmitScope> batch_submit_scopes = {};
         usize swapchain_image_first_use_submit_scope_index = std::numeric_limits<usize>::max();
         usize swapchain_image_last_use_submit_scope_index = std::numeric_limits<usize>::max();
+        // Set when any submit scope runs on a compute or transfer queue.
+        bool uses_async_queues = {};
 
         void add_task(ImplTaskGraph & task_graph_impl, ImplTask & impl_task, TaskId task_id);
         void submit(TaskSubmitInfo const & info);
@@ -385,6 +394,9 @@ namespace daxa
 
         // execution time information:
         std::optional<daxa::TransferMemoryPool> staging_memory = {};
+        // Signaled by the submit scopes of each queue, created on first use. Index with queue_flat_index.
+        std::array<TimelineSemaphore, DAXA_TASK_GRAPH_QUEUE_COUNT> queue_timeline_semaphores = {};
+        std::array<u64, DAXA_TASK_GRAPH_QUEUE_COUNT> queue_timeline_values = {};
         std::array<bool, DAXA_TASK_GRAPH_MAX_CONDITIONALS> execution_time_current_conditionals = {};
 
         // post execution information: